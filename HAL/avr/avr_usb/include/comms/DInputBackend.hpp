@@ -6,6 +6,7 @@
 #include "core/CommunicationBackend.hpp"
 #include "core/ControllerMode.hpp"
 #include "core/InputSource.hpp"
+#include "modes/MeleeLimits.hpp"
 
 #include <Joystick.h>
 
@@ -14,11 +15,14 @@ class DInputBackend : public CommunicationBackend {
     DInputBackend(InputSource **input_sources, size_t input_source_count, bool nerfOn);
     ~DInputBackend();
     void SendReport();
+    void SetGameMode(ControllerMode *gamemode);
 
   private:
     int16_t GetDpadAngle(bool left, bool right, bool down, bool up);
     Joystick_ *_joystick;
     bool _nerfOn;
+    MeleeLimiter _limiter;
+    uint32_t _loop_start;
 };
 
 #endif
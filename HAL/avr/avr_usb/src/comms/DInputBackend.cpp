@@ -1,15 +1,18 @@
 #include "comms/DInputBackend.hpp"
-#include "comms/hwtimer.hpp"
 
 #include "core/CommunicationBackend.hpp"
 #include "core/state.hpp"
 
-#include "modes/MeleeLimits.hpp"
+#include "timebase.hpp"
 
 #include <Joystick.h>
 
 //#define TIMINGDEBUG
 
+// Spinlock to make things about 720 hz, about the fastest it'll go while running the b0xx input
+// viewer.
+#define SAMPLE_SPACING_US 1400
+
 DInputBackend::DInputBackend(InputSource **input_sources, size_t input_source_count, bool nerfOn)
     : CommunicationBackend(input_sources, input_source_count) {
     _joystick = new Joystick_(
@@ -31,11 +34,7 @@ DInputBackend::DInputBackend(InputSource **input_sources, size_t input_source_co
     );
 
     _nerfOn = nerfOn;
-
-    //Set up hardware timer
-    TCCR1A = 0;
-    TCCR1B = (1 << CS11) | (1 << CS10);//64 clock divider -> 4 microsecond resolution
-    zeroTcnt1();
+    _loop_start = 0;
 
     //Serial.begin(115200);
     //Serial.println("Testing serial output");
@@ -55,17 +54,8 @@ DInputBackend::~DInputBackend() {
 }
 
 void DInputBackend::SendReport() {
-    static uint sampleSpacing = 350;
-    //static uint16_t loopTime = 16383;
-
-    while(readTcnt1() < sampleSpacing) {
-        //spinlock to make things about 720 hz, about the fastest it'll go while running the b0xx input viewer
-    }
-
-    //read how long this loop took
-    //loopTime = readTcnt1();//each unit is 4 microseconds
-    //zero the counter so that it doesn't overflow
-    zeroTcnt1();
+    timebase::wait_until(_loop_start + SAMPLE_SPACING_US);
+    _loop_start = timebase::now_us();
     //Serial.print("Loop time: ");
     //Serial.println(loopTime);
 
@@ -75,10 +65,10 @@ void DInputBackend::SendReport() {
     UpdateOutputs();
 
     //if(_nerfOn) {
-    if(_gamemode->isMelee()) {
+    if(_gamemode != nullptr && _gamemode->isMelee()) {
         //APPLY NERFS HERE
         OutputState nerfedOutputs;
-        limitOutputs(sampleSpacing, _nerfOn ? AB_A : AB_B, _inputs, _outputs, nerfedOutputs);
+        _limiter.LimitOutputs(_loop_start, _nerfOn ? AB_A : AB_B, _inputs, _outputs, nerfedOutputs);
 
         // Digital outputs
         _joystick->setButton(0, nerfedOutputs.b);
@@ -142,6 +132,11 @@ void DInputBackend::SendReport() {
     _joystick->sendState();
 }
 
+void DInputBackend::SetGameMode(ControllerMode *gamemode) {
+    CommunicationBackend::SetGameMode(gamemode);
+    _limiter.Reset();
+}
+
 int16_t DInputBackend::GetDpadAngle(bool left, bool right, bool down, bool up) {
     int16_t angle = -1;
     if (right && !left) {
@@ -2,7 +2,9 @@
 #define _COMMS_GAMECUBEBACKEND_HPP
 
 #include "core/CommunicationBackend.hpp"
+#include "core/SampleScheduler.hpp"
 #include "core/state.hpp"
+#include "modes/MeleeLimits.hpp"
 
 #include <Nintendo.h>
 
@@ -16,12 +18,28 @@ class GamecubeBackend : public CommunicationBackend {
     );
     ~GamecubeBackend();
     void SendReport();
+    void SetGameMode(ControllerMode *gamemode);
+    // Fixes how long before the end of each sample slot inputs are sampled, instead of measuring
+    // how long it takes to process a sample. 0 goes back to measuring it.
+    void SetSampleOffset(uint32_t offset_us);
+    // Sets how often inputs are sampled between polls for the nerfs, 1000Hz by default. It's
+    // lowered to what the platform can keep up with. 0 goes back to the default.
+    void SetSampleRate(uint32_t rate_hz);
+    // Polls that came before the report was ready, polls that went unanswered, and samples that
+    // were skipped so as not to hold up a poll, since startup.
+    uint32_t LatePolls();
+    uint32_t MissedPolls();
+    uint32_t SkippedSamples();
 
   private:
     CGamecubeConsole *_gamecube;
     Gamecube_Data_t _data;
     int _delay;
     bool _nerfOn;
+    SampleScheduler _scheduler;
+    MeleeLimiter _limiter;
+
+    void UpdateReport(const OutputState &outputs);
 };
 
 #endif
@@ -3,6 +3,7 @@
 
 #include "core/CommunicationBackend.hpp"
 #include "core/InputSource.hpp"
+#include "core/SampleScheduler.hpp"
 
 #include <Nintendo.h>
 
@@ -16,11 +17,22 @@ class N64Backend : public CommunicationBackend {
     );
     ~N64Backend();
     void SendReport();
+    void SetGameMode(ControllerMode *gamemode);
+    // Fixes how long before the poll inputs are sampled, instead of measuring how long it takes to
+    // process a sample. 0 goes back to measuring it.
+    void SetSampleOffset(uint32_t offset_us);
+    // Polls that came before the report was ready, polls that went unanswered, and samples that
+    // were skipped so as not to hold up a poll, since startup.
+    uint32_t LatePolls();
+    uint32_t MissedPolls();
+    uint32_t SkippedSamples();
 
   private:
     CN64Console *_n64;
     N64_Data_t _data;
-    int _delay;
+    SampleScheduler _scheduler;
+
+    void UpdateReport();
 };
 
 #endif
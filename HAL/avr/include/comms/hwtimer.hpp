@@ -1,9 +0,0 @@
-#ifndef HWTIMER_H
-#define HWTIMER_H
-#include "stdlib.hpp"
-
-void zeroTcnt1();
-
-uint16_t readTcnt1();
-
-#endif //HWTIMER_H
@@ -1,6 +1,7 @@
 #ifndef _GPIO_HPP
 #define _GPIO_HPP
 
+#include "gpio_pin_map.hpp"
 #include "stdlib.hpp"
 
 namespace gpio {
@@ -14,12 +15,44 @@ namespace gpio {
     void init_pin(uint pin, GpioMode mode);
 
     inline bool read_digital(uint pin) {
-        return digitalRead(pin);
+        PinLocation location = pin_location(pin);
+        return *port_register(location.port, reg_pin) & location.mask;
     }
 
     inline void write_digital(uint pin, bool value) {
-        digitalWrite(pin, value);
+        PinLocation location = pin_location(pin);
+        volatile uint8_t *out = port_register(location.port, reg_port);
+
+        // Read-modify-write of the port, so make sure an interrupt touching the same port can't
+        // get in between.
+        uint8_t oldSREG = SREG;
+        cli();
+        if (value) {
+            *out |= location.mask;
+        } else {
+            *out &= ~location.mask;
+        }
+        SREG = oldSREG;
+    }
+
+    // Bulk access. Every pin belongs to a port whose levels can all be read in a single access, so
+    // input sources can sample many pins at the same instant.
+    inline uint pin_port(uint pin) {
+        return pin_location(pin).port;
+    }
+
+    inline uint32_t pin_mask(uint pin) {
+        return pin_location(pin).mask;
+    }
+
+    // Reads every port back to back into levels, which must hold port_count entries. Unrolled at
+    // compile time so that each port is a single load from a constant address.
+    template <uint8_t port = 0> inline void read_all_ports(uint32_t *levels) {
+        if constexpr (port < port_count) {
+            levels[port] = *(volatile uint8_t *)port_input_registers[port];
+            read_all_ports<port + 1>(levels);
+        }
     }
 }
 
-#endif
\ No newline at end of file
+#endif
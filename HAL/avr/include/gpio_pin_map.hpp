@@ -0,0 +1,209 @@
+#ifndef _GPIO_PIN_MAP_HPP
+#define _GPIO_PIN_MAP_HPP
+
+#include "stdlib.hpp"
+
+#include <avr/pgmspace.h>
+
+/*
+ * Compile-time map from Arduino pin numbers to the I/O port and bit backing each pin, mirroring
+ * the pins_arduino.h of the variant used for each MCU. Ports are identified by their index in
+ * port_input_registers, which holds the data space address of each port's PINx register. The DDRx
+ * and PORTx registers of a port always immediately follow its PINx register.
+ */
+
+namespace gpio {
+    typedef struct {
+        uint8_t port;
+        uint8_t mask;
+    } PinLocation;
+
+#define PIN_LOCATION(port, bit) { port, 1 << bit }
+
+#if defined(__AVR_ATmega32U4__)
+    // Leonardo/Micro variant.
+    enum : uint8_t { port_b, port_c, port_d, port_e, port_f };
+
+    constexpr uint16_t port_input_registers[] PROGMEM = { 0x23, 0x26, 0x29, 0x2C, 0x2F };
+
+    constexpr PinLocation pin_locations[] PROGMEM = {
+        PIN_LOCATION(port_d, 2), // D0
+        PIN_LOCATION(port_d, 3), // D1
+        PIN_LOCATION(port_d, 1), // D2
+        PIN_LOCATION(port_d, 0), // D3
+        PIN_LOCATION(port_d, 4), // D4
+        PIN_LOCATION(port_c, 6), // D5
+        PIN_LOCATION(port_d, 7), // D6
+        PIN_LOCATION(port_e, 6), // D7
+        PIN_LOCATION(port_b, 4), // D8
+        PIN_LOCATION(port_b, 5), // D9
+        PIN_LOCATION(port_b, 6), // D10
+        PIN_LOCATION(port_b, 7), // D11
+        PIN_LOCATION(port_d, 6), // D12
+        PIN_LOCATION(port_c, 7), // D13
+        PIN_LOCATION(port_b, 3), // D14 (MISO)
+        PIN_LOCATION(port_b, 1), // D15 (SCK)
+        PIN_LOCATION(port_b, 2), // D16 (MOSI)
+        PIN_LOCATION(port_b, 0), // D17 (SS/RXLED)
+        PIN_LOCATION(port_f, 7), // D18 (A0)
+        PIN_LOCATION(port_f, 6), // D19 (A1)
+        PIN_LOCATION(port_f, 5), // D20 (A2)
+        PIN_LOCATION(port_f, 4), // D21 (A3)
+        PIN_LOCATION(port_f, 1), // D22 (A4)
+        PIN_LOCATION(port_f, 0), // D23 (A5)
+        PIN_LOCATION(port_d, 4), // D24 (A6)
+        PIN_LOCATION(port_d, 7), // D25 (A7)
+        PIN_LOCATION(port_b, 4), // D26 (A8)
+        PIN_LOCATION(port_b, 5), // D27 (A9)
+        PIN_LOCATION(port_b, 6), // D28 (A10)
+        PIN_LOCATION(port_d, 6), // D29 (A11)
+        PIN_LOCATION(port_d, 5), // D30 (TXLED)
+    };
+#elif defined(__AVR_ATmega328P__)
+    // Uno/Nano (standard) variant.
+    enum : uint8_t { port_b, port_c, port_d };
+
+    constexpr uint16_t port_input_registers[] PROGMEM = { 0x23, 0x26, 0x29 };
+
+    constexpr PinLocation pin_locations[] PROGMEM = {
+        PIN_LOCATION(port_d, 0), // D0
+        PIN_LOCATION(port_d, 1), // D1
+        PIN_LOCATION(port_d, 2), // D2
+        PIN_LOCATION(port_d, 3), // D3
+        PIN_LOCATION(port_d, 4), // D4
+        PIN_LOCATION(port_d, 5), // D5
+        PIN_LOCATION(port_d, 6), // D6
+        PIN_LOCATION(port_d, 7), // D7
+        PIN_LOCATION(port_b, 0), // D8
+        PIN_LOCATION(port_b, 1), // D9
+        PIN_LOCATION(port_b, 2), // D10
+        PIN_LOCATION(port_b, 3), // D11
+        PIN_LOCATION(port_b, 4), // D12
+        PIN_LOCATION(port_b, 5), // D13
+        PIN_LOCATION(port_c, 0), // D14 (A0)
+        PIN_LOCATION(port_c, 1), // D15 (A1)
+        PIN_LOCATION(port_c, 2), // D16 (A2)
+        PIN_LOCATION(port_c, 3), // D17 (A3)
+        PIN_LOCATION(port_c, 4), // D18 (A4)
+        PIN_LOCATION(port_c, 5), // D19 (A5)
+    };
+#elif defined(__AVR_ATmega2560__)
+    // Mega variant.
+    enum : uint8_t {
+        port_a,
+        port_b,
+        port_c,
+        port_d,
+        port_e,
+        port_f,
+        port_g,
+        port_h,
+        port_j,
+        port_k,
+        port_l,
+    };
+
+    constexpr uint16_t port_input_registers[] PROGMEM = {
+        0x20, 0x23, 0x26, 0x29, 0x2C, 0x2F, 0x32, 0x100, 0x103, 0x106, 0x109,
+    };
+
+    constexpr PinLocation pin_locations[] PROGMEM = {
+        PIN_LOCATION(port_e, 0), // D0
+        PIN_LOCATION(port_e, 1), // D1
+        PIN_LOCATION(port_e, 4), // D2
+        PIN_LOCATION(port_e, 5), // D3
+        PIN_LOCATION(port_g, 5), // D4
+        PIN_LOCATION(port_e, 3), // D5
+        PIN_LOCATION(port_h, 3), // D6
+        PIN_LOCATION(port_h, 4), // D7
+        PIN_LOCATION(port_h, 5), // D8
+        PIN_LOCATION(port_h, 6), // D9
+        PIN_LOCATION(port_b, 4), // D10
+        PIN_LOCATION(port_b, 5), // D11
+        PIN_LOCATION(port_b, 6), // D12
+        PIN_LOCATION(port_b, 7), // D13
+        PIN_LOCATION(port_j, 1), // D14
+        PIN_LOCATION(port_j, 0), // D15
+        PIN_LOCATION(port_h, 1), // D16
+        PIN_LOCATION(port_h, 0), // D17
+        PIN_LOCATION(port_d, 3), // D18
+        PIN_LOCATION(port_d, 2), // D19
+        PIN_LOCATION(port_d, 1), // D20
+        PIN_LOCATION(port_d, 0), // D21
+        PIN_LOCATION(port_a, 0), // D22
+        PIN_LOCATION(port_a, 1), // D23
+        PIN_LOCATION(port_a, 2), // D24
+        PIN_LOCATION(port_a, 3), // D25
+        PIN_LOCATION(port_a, 4), // D26
+        PIN_LOCATION(port_a, 5), // D27
+        PIN_LOCATION(port_a, 6), // D28
+        PIN_LOCATION(port_a, 7), // D29
+        PIN_LOCATION(port_c, 7), // D30
+        PIN_LOCATION(port_c, 6), // D31
+        PIN_LOCATION(port_c, 5), // D32
+        PIN_LOCATION(port_c, 4), // D33
+        PIN_LOCATION(port_c, 3), // D34
+        PIN_LOCATION(port_c, 2), // D35
+        PIN_LOCATION(port_c, 1), // D36
+        PIN_LOCATION(port_c, 0), // D37
+        PIN_LOCATION(port_d, 7), // D38
+        PIN_LOCATION(port_g, 2), // D39
+        PIN_LOCATION(port_g, 1), // D40
+        PIN_LOCATION(port_g, 0), // D41
+        PIN_LOCATION(port_l, 7), // D42
+        PIN_LOCATION(port_l, 6), // D43
+        PIN_LOCATION(port_l, 5), // D44
+        PIN_LOCATION(port_l, 4), // D45
+        PIN_LOCATION(port_l, 3), // D46
+        PIN_LOCATION(port_l, 2), // D47
+        PIN_LOCATION(port_l, 1), // D48
+        PIN_LOCATION(port_l, 0), // D49
+        PIN_LOCATION(port_b, 3), // D50 (MISO)
+        PIN_LOCATION(port_b, 2), // D51 (MOSI)
+        PIN_LOCATION(port_b, 1), // D52 (SCK)
+        PIN_LOCATION(port_b, 0), // D53 (SS)
+        PIN_LOCATION(port_f, 0), // D54 (A0)
+        PIN_LOCATION(port_f, 1), // D55 (A1)
+        PIN_LOCATION(port_f, 2), // D56 (A2)
+        PIN_LOCATION(port_f, 3), // D57 (A3)
+        PIN_LOCATION(port_f, 4), // D58 (A4)
+        PIN_LOCATION(port_f, 5), // D59 (A5)
+        PIN_LOCATION(port_f, 6), // D60 (A6)
+        PIN_LOCATION(port_f, 7), // D61 (A7)
+        PIN_LOCATION(port_k, 0), // D62 (A8)
+        PIN_LOCATION(port_k, 1), // D63 (A9)
+        PIN_LOCATION(port_k, 2), // D64 (A10)
+        PIN_LOCATION(port_k, 3), // D65 (A11)
+        PIN_LOCATION(port_k, 4), // D66 (A12)
+        PIN_LOCATION(port_k, 5), // D67 (A13)
+        PIN_LOCATION(port_k, 6), // D68 (A14)
+        PIN_LOCATION(port_k, 7), // D69 (A15)
+    };
+#else
+#error "No GPIO pin map for this MCU. Add one to gpio_pin_map.hpp."
+#endif
+
+#undef PIN_LOCATION
+
+    constexpr size_t port_count = sizeof(port_input_registers) / sizeof(port_input_registers[0]);
+
+    // When the pin/port is known at compile time these fold down to constants, so a pin access
+    // compiles to a single instruction. Otherwise the location is fetched from flash.
+    inline PinLocation pin_location(uint pin) {
+        if (__builtin_constant_p(pin)) {
+            return pin_locations[pin];
+        }
+        return { pgm_read_byte(&pin_locations[pin].port), pgm_read_byte(&pin_locations[pin].mask) };
+    }
+
+    inline volatile uint8_t *port_register(uint8_t port, uint8_t offset) {
+        uint16_t address = __builtin_constant_p(port) ? port_input_registers[port]
+                                                      : pgm_read_word(&port_input_registers[port]);
+        return (volatile uint8_t *)(address + offset);
+    }
+
+    // Offsets of each register from the start of a port's register block.
+    enum : uint8_t { reg_pin, reg_ddr, reg_port };
+}
+
+#endif
@@ -5,4 +5,11 @@
 
 typedef unsigned int uint;
 
+// AVR runs everything from flash, see the Pico HAL for what these are for.
+#define RAM_FUNC(func_name) func_name
+#define RAM_DATA(group)
+
+// There is only one core, so only the compiler has to be kept from reordering memory accesses.
+#define memory_barrier() __asm__ __volatile__("" ::: "memory")
+
 #endif
@@ -0,0 +1,58 @@
+#ifndef _TIMEBASE_HPP
+#define _TIMEBASE_HPP
+
+#include "stdlib.hpp"
+
+/*
+ * Monotonic time in microseconds since boot, and waits/alarms against it. All timing code goes
+ * through here so that it can run against a simulated clock on the host. 32-bit times wrap around
+ * every ~71 minutes, so compare them by subtraction, as reached() does, rather than directly.
+ *
+ * Timer1 is the time source. Unlike micros(), which counts Timer0 overflows in an interrupt, it
+ * keeps counting while the joybus libraries have interrupts disabled. Its resolution is 64 CPU
+ * cycles (4us at 16MHz).
+ */
+
+namespace timebase {
+    constexpr uint32_t us_per_tick = 64 / (F_CPU / 1000000);
+
+    uint32_t now_us();
+
+    uint64_t now_us64();
+
+    inline bool reached(uint32_t deadline_us) {
+        return (int32_t)(now_us() - deadline_us) >= 0;
+    }
+
+    // Spins until the deadline. Returns whether there was any time left to wait.
+    inline bool wait_until(uint32_t deadline_us) {
+        if (reached(deadline_us)) {
+            return false;
+        }
+        while (!reached(deadline_us)) {
+        }
+        return true;
+    }
+
+    inline void wait_us(uint32_t duration_us) {
+        wait_until(now_us() + duration_us);
+    }
+
+    // Sleeping until the alarm would rely on its interrupt being serviced on time, which the joybus
+    // libraries don't allow for as they keep interrupts disabled during transfers, so this spins.
+    inline bool sleep_until(uint32_t deadline_us) {
+        return wait_until(deadline_us);
+    }
+
+    typedef void (*AlarmCallback)(void *context);
+
+    // Calls callback from interrupt context once the deadline is reached. There is a single alarm,
+    // so scheduling another replaces any that is pending. Returns false if the deadline has already
+    // passed or is more than one Timer1 period (262ms at 16MHz) away, in which case nothing is
+    // scheduled.
+    bool schedule_alarm(uint32_t deadline_us, AlarmCallback callback, void *context);
+
+    void cancel_alarm();
+}
+
+#endif
@@ -1,10 +1,9 @@
 #include "comms/GamecubeBackend.hpp"
-#include "comms/hwtimer.hpp"
 
 #include "core/ControllerMode.hpp"
 #include "core/InputSource.hpp"
 
-#include "modes/MeleeLimits.hpp"
+#include "timebase.hpp"
 
 #include <Nintendo.h>
 
@@ -16,7 +15,11 @@ GamecubeBackend::GamecubeBackend(
     int polling_rate,
     int data_pin
 )
-    : CommunicationBackend(input_sources, input_source_count) {
+    : CommunicationBackend(input_sources, input_source_count),
+      // 975us is the fastest sample loop on AVR. The computation time is calibrated, but starts
+      // out with 700us for sampling plus 250us for the nerfs, less the poll lead. write() returns
+      // once it has answered the poll, 90 bits at 4us each after the poll started.
+      _scheduler(975, 700 + 250 - 360, 360) {
     _gamecube = new CGamecubeConsole(data_pin);
     _data = defaultGamecubeData;
 
@@ -41,11 +44,6 @@ GamecubeBackend::GamecubeBackend(
 #ifdef TIMINGDEBUG
     pinMode(21, OUTPUT);
 #endif
-
-    //Set up hardware timer
-    TCCR1A = 0;
-    TCCR1B = (1 << CS11) | (1 << CS10);//64 clock divider -> 4 microsecond resolution
-    zeroTcnt1();
 }
 
 GamecubeBackend::~GamecubeBackend() {
@@ -53,115 +51,41 @@ GamecubeBackend::~GamecubeBackend() {
 }
 
 void GamecubeBackend::SendReport() {
-    static bool status = false;//true = normal poll
-    static uint32_t minLoop = 16384;
-    static uint loopCount = 0;
-    static bool detect = true;//false means run
-    static uint sampleCount = 1;
-    static uint sampleSpacing = 0;
-    static uint16_t loopTime = 0;
-    const uint fastestLoop = 975; //fastest possible loop; platform-dependent
-    //const uint fastestLoop = 450; //fastest possible loop; platform-dependent
-
-    //read how long this loop took
-    loopTime = readTcnt1();//each unit is 4 microseconds
-    //zero the counter so that it doesn't overflow
-    zeroTcnt1();
-
-    if(detect && status) {
+    _scheduler.StartLoop(timebase::now_us());
+
+    if(_scheduler.Detecting()) {
         //run loop time detection procedure
 #ifdef TIMINGDEBUG
         digitalWrite(21, HIGH);
 #endif
-        loopCount++;
-        if(loopCount > 5 && loopTime > 300/4) {//screen out implausibly fast samples; the limit is 2500 Hz (400 us) so we use 300 us as the limit, ignore first few polls
-            minLoop = min(minLoop, loopTime);
-        }
-        if(loopCount >= 100) {
-            detect = false;
-            sampleCount = 1;
-            while(1000/4*sampleCount <= minLoop) {//we want [sampleCount] ms-spaced samples within the smallest possible loop
-                sampleCount++;
-            }
-            sampleSpacing = minLoop / sampleCount;
-            if(sampleSpacing < (fastestLoop/4) && sampleCount > 1) {
-                sampleCount--;
-                sampleSpacing = minLoop / sampleCount;
-            }
-            /*
-            Serial.print("Loop time: ");
-            Serial.println(loopTime);
-            Serial.print("Fastest Loop: ");
-            Serial.println(minLoop);
-            Serial.print("Sample count: ");
-            Serial.println(sampleCount);
-            Serial.print("Sample spacing: ");
-            Serial.println(sampleSpacing);
-            */
-        }
         // Make sure to respond while measuring.
         ScanInputs();
 
         // Run gamemode logic.
         UpdateOutputs();
 
-        // Digital outputs
-        _data.report.a = _outputs.a;
-        _data.report.b = _outputs.b;
-        _data.report.x = _outputs.x;
-        _data.report.y = _outputs.y;
-        _data.report.z = _outputs.buttonR;
-        _data.report.l = _outputs.triggerLDigital;
-        _data.report.r = _outputs.triggerRDigital;
-        _data.report.start = _outputs.start;
-        _data.report.dleft = _outputs.dpadLeft | _outputs.select;
-        _data.report.dright = _outputs.dpadRight | _outputs.home;
-        _data.report.ddown = _outputs.dpadDown;
-        _data.report.dup = _outputs.dpadUp;
-
-        // Analog outputs
-        _data.report.xAxis = _outputs.leftStickX;
-        _data.report.yAxis = _outputs.leftStickY;
-        _data.report.cxAxis = _outputs.rightStickX;
-        _data.report.cyAxis = _outputs.rightStickY;
-        _data.report.left = _outputs.triggerLAnalog + 31;
-        _data.report.right = _outputs.triggerRAnalog + 31;
+        UpdateReport(_outputs);
     } else {
-        if(loopTime > minLoop+(minLoop >> 1)) {//if the loop time is 50% longer than expected
-            /*
-            Serial.println("Loop time too long?");
-            Serial.print("Loop time: ");
-            Serial.println(loopTime);
-            Serial.print("TCNT1: ");
-            Serial.println(readTcnt1());
-            zeroTcnt1();
-            Serial.print("TCNT1: ");
-            Serial.println(readTcnt1());
-            */
-            detect = true;//stop scanning inputs briefly and re-measure timings
-            loopCount = 0;
-            sampleCount = 1;
-            sampleSpacing = 0;
-            loopTime = 0;
-        }
         //run the delay procedure based on samplespacing
         //in the stock arduino software, it samples 850 us after the end of the poll response
         //we want the last sample to begin [850 + extra computation time] before the beginning of the last poll to give room for the sample and the travel time+nerf computation
         //
-        for (uint i = 0; i < sampleCount; i++) {
+        // Only the last sample's report goes out, so the ones before it aren't packed.
+        OutputState sampleOutputs;
+        for (uint i = 0; i < _scheduler.SampleCount(); i++) {
 #ifdef TIMINGDEBUG
             digitalWrite(21, LOW);
 #endif
 
-            const uint16_t nerfTime = 250/4;
-            const uint16_t computationTime = 700/4 + nerfTime;//*_nerfOn;//depends on the platform; 4us steps.
-            //700 microseconds is sufficient with no travel time computation
-            const uint16_t targetTime = ((i+1)*sampleSpacing)-computationTime;
-            //const uint16_t targetTime = i*sampleSpacing;
-            int count = 0;
-            while(readTcnt1() < targetTime) {
-                count++;//do something?
-                //spinlock
+            [[maybe_unused]] const bool waited = timebase::sleep_until(_scheduler.SampleDeadline(i));
+            const uint32_t sampleStart = timebase::now_us();
+            // Rather than risk missing the poll, answer it with the report from the last sample.
+            if (!_scheduler.SampleFitsBeforePoll(sampleStart)) {
+                _scheduler.RecordSkippedSamples(_scheduler.SampleCount() - i);
+                if (i > 0) {
+                    UpdateReport(sampleOutputs);
+                }
+                break;
             }
 
             ScanInputs();
@@ -170,57 +94,20 @@ void GamecubeBackend::SendReport() {
             UpdateOutputs();
 
             //if(_nerfOn) {
-            if(_gamemode->isMelee()) {
+            if(_gamemode != nullptr && _gamemode->isMelee()) {
                 //APPLY NERFS HERE
-                OutputState nerfedOutputs;
-                limitOutputs(sampleSpacing, _nerfOn ? AB_A : AB_B, _inputs, _outputs, nerfedOutputs);
-                // Digital outputs
-                _data.report.a = nerfedOutputs.a;
-                _data.report.b = nerfedOutputs.b;
-                _data.report.x = nerfedOutputs.x;
-                _data.report.y = nerfedOutputs.y;
-                _data.report.z = nerfedOutputs.buttonR;
-                _data.report.l = nerfedOutputs.triggerLDigital;
-                _data.report.r = nerfedOutputs.triggerRDigital;
-                _data.report.start = nerfedOutputs.start;
-                _data.report.dleft = nerfedOutputs.dpadLeft | nerfedOutputs.select;
-                _data.report.dright = nerfedOutputs.dpadRight | nerfedOutputs.home;
-                _data.report.ddown = nerfedOutputs.dpadDown;
-                _data.report.dup = nerfedOutputs.dpadUp;
-
-                // Analog outputs
-                _data.report.xAxis = nerfedOutputs.leftStickX;
-                _data.report.yAxis = nerfedOutputs.leftStickY;
-                _data.report.cxAxis = nerfedOutputs.rightStickX;
-                _data.report.cyAxis = nerfedOutputs.rightStickY;
-                _data.report.left = nerfedOutputs.triggerLAnalog + 31;
-                _data.report.right = nerfedOutputs.triggerRAnalog + 31;
+                _limiter.LimitOutputs(sampleStart, _nerfOn ? AB_A : AB_B, _inputs, _outputs, sampleOutputs);
             } else {
-                // Digital outputs
-                _data.report.a = _outputs.a;
-                _data.report.b = _outputs.b;
-                _data.report.x = _outputs.x;
-                _data.report.y = _outputs.y;
-                _data.report.z = _outputs.buttonR;
-                _data.report.l = _outputs.triggerLDigital;
-                _data.report.r = _outputs.triggerRDigital;
-                _data.report.start = _outputs.start;
-                _data.report.dleft = _outputs.dpadLeft | _outputs.select;
-                _data.report.dright = _outputs.dpadRight | _outputs.home;
-                _data.report.ddown = _outputs.dpadDown;
-                _data.report.dup = _outputs.dpadUp;
-
-                // Analog outputs
-                _data.report.xAxis = _outputs.leftStickX;
-                _data.report.yAxis = _outputs.leftStickY;
-                _data.report.cxAxis = _outputs.rightStickX;
-                _data.report.cyAxis = _outputs.rightStickY;
-                _data.report.left = _outputs.triggerLAnalog + 31;
-                _data.report.right = _outputs.triggerRAnalog + 31;
+                sampleOutputs = _outputs;
+            }
+            if (i == _scheduler.SampleCount() - 1) {
+                UpdateReport(sampleOutputs);
             }
 
+            _scheduler.RecordComputationTime(timebase::now_us() - sampleStart);
+
 #ifdef TIMINGDEBUG
-            digitalWrite(21, count ? HIGH : LOW);
+            digitalWrite(21, waited ? HIGH : LOW);
 #endif
         }
     }
@@ -229,8 +116,62 @@ void GamecubeBackend::SendReport() {
     digitalWrite(21, HIGH);
 #endif
     // Send outputs to console.
-    status = _gamecube->write(_data);
+    _scheduler.StartWaitForPoll(timebase::now_us());
+    if (!_gamecube->write(_data)) {
+        _scheduler.RecordMissedPoll();
+    }
 #ifdef TIMINGDEBUG
     digitalWrite(21, LOW);
 #endif
 }
+
+void GamecubeBackend::UpdateReport(const OutputState &outputs) {
+    // Digital outputs
+    _data.report.a = outputs.a;
+    _data.report.b = outputs.b;
+    _data.report.x = outputs.x;
+    _data.report.y = outputs.y;
+    _data.report.z = outputs.buttonR;
+    _data.report.l = outputs.triggerLDigital;
+    _data.report.r = outputs.triggerRDigital;
+    _data.report.start = outputs.start;
+    _data.report.dleft = outputs.dpadLeft | outputs.select;
+    _data.report.dright = outputs.dpadRight | outputs.home;
+    _data.report.ddown = outputs.dpadDown;
+    _data.report.dup = outputs.dpadUp;
+
+    // Analog outputs
+    _data.report.xAxis = outputs.leftStickX;
+    _data.report.yAxis = outputs.leftStickY;
+    _data.report.cxAxis = outputs.rightStickX;
+    _data.report.cyAxis = outputs.rightStickY;
+    _data.report.left = outputs.triggerLAnalog + 31;
+    _data.report.right = outputs.triggerRAnalog + 31;
+}
+
+void GamecubeBackend::SetGameMode(ControllerMode *gamemode) {
+    CommunicationBackend::SetGameMode(gamemode);
+    // Modes differ in how long they take to process a sample.
+    _scheduler.ResetComputationTime();
+    _limiter.Reset();
+}
+
+void GamecubeBackend::SetSampleOffset(uint32_t offset_us) {
+    _scheduler.SetSampleOffset(offset_us);
+}
+
+void GamecubeBackend::SetSampleRate(uint32_t rate_hz) {
+    _scheduler.SetSampleInterval(rate_hz > 0 ? 1000000 / rate_hz : 0);
+}
+
+uint32_t GamecubeBackend::LatePolls() {
+    return _scheduler.LatePolls();
+}
+
+uint32_t GamecubeBackend::MissedPolls() {
+    return _scheduler.MissedPolls();
+}
+
+uint32_t GamecubeBackend::SkippedSamples() {
+    return _scheduler.SkippedSamples();
+}
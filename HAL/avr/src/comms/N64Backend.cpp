@@ -1,5 +1,7 @@
 #include "comms/N64Backend.hpp"
 
+#include "timebase.hpp"
+
 #include <Nintendo.h>
 
 N64Backend::N64Backend(
@@ -8,18 +10,16 @@ N64Backend::N64Backend(
     int polling_rate,
     int data_pin
 )
-    : CommunicationBackend(input_sources, input_source_count) {
+    : CommunicationBackend(input_sources, input_source_count),
+      // Without nerfs to run there's no use in sampling more than once per poll. The computation
+      // time is calibrated, but starts out with the 850us that used to be left for processing,
+      // less the poll lead. write() returns once it has answered the poll, around 42 bits at 4us
+      // each after the poll started.
+      _scheduler(975, 850 - 170, 170, 1) {
     _n64 = new CN64Console(data_pin);
     _data = defaultN64Data;
 
-    if (polling_rate > 0) {
-        // Delay used between input updates to postpone them until right before the
-        // next poll, while also leaving time (850us) for processing to finish.
-        _delay = (1000000 / polling_rate) - 850;
-    } else {
-        // If polling rate is set to 0, disable the delay.
-        _delay = 0;
-    }
+    // polling_rate is no longer needed, as the poll timing is tracked instead.
 }
 
 N64Backend::~N64Backend() {
@@ -27,12 +27,43 @@ N64Backend::~N64Backend() {
 }
 
 void N64Backend::SendReport() {
-    // Update inputs from all sources at once.
-    ScanInputs();
+    _scheduler.StartLoop(timebase::now_us());
+
+    if (_scheduler.Detecting()) {
+        // Make sure to respond while measuring.
+        ScanInputs();
+
+        // Run gamemode logic.
+        UpdateOutputs();
+
+        UpdateReport();
+    } else {
+        // Sample as late as possible before the next poll.
+        timebase::sleep_until(_scheduler.SampleDeadline(0));
+        const uint32_t sampleStart = timebase::now_us();
+        // Rather than risk missing the poll, answer it with the previous report.
+        if (_scheduler.SampleFitsBeforePoll(sampleStart)) {
+            ScanInputs();
+
+            // Run gamemode logic.
+            UpdateOutputs();
+
+            UpdateReport();
 
-    // Run gamemode logic.
-    UpdateOutputs();
+            _scheduler.RecordComputationTime(timebase::now_us() - sampleStart);
+        } else {
+            _scheduler.RecordSkippedSamples(1);
+        }
+    }
 
+    // Send outputs to console.
+    _scheduler.StartWaitForPoll(timebase::now_us());
+    if (!_n64->write(_data)) {
+        _scheduler.RecordMissedPoll();
+    }
+}
+
+void N64Backend::UpdateReport() {
     // Digital outputs
     _data.report.a = _outputs.a;
     _data.report.b = _outputs.b;
@@ -53,9 +84,26 @@ void N64Backend::SendReport() {
     // Analog outputs - converted from unsigned to signed 8-bit integers
     _data.report.xAxis = _outputs.leftStickX - 128;
     _data.report.yAxis = _outputs.leftStickY - 128;
+}
 
-    // Send outputs to console.
-    _n64->write(_data);
+void N64Backend::SetGameMode(ControllerMode *gamemode) {
+    CommunicationBackend::SetGameMode(gamemode);
+    // Modes differ in how long they take to process a sample.
+    _scheduler.ResetComputationTime();
+}
+
+void N64Backend::SetSampleOffset(uint32_t offset_us) {
+    _scheduler.SetSampleOffset(offset_us);
+}
+
+uint32_t N64Backend::LatePolls() {
+    return _scheduler.LatePolls();
+}
+
+uint32_t N64Backend::MissedPolls() {
+    return _scheduler.MissedPolls();
+}
 
-    delayMicroseconds(_delay);
+uint32_t N64Backend::SkippedSamples() {
+    return _scheduler.SkippedSamples();
 }
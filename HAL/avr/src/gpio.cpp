@@ -2,15 +2,23 @@
 
 #include "stdlib.hpp"
 
-// TODO: Might be better to replace with port manipulation
 namespace gpio {
     void init_pin(uint pin, GpioMode mode) {
+        PinLocation location = pin_location(pin);
+        volatile uint8_t *ddr = port_register(location.port, reg_ddr);
+        volatile uint8_t *out = port_register(location.port, reg_port);
+
+        uint8_t oldSREG = SREG;
+        cli();
         if (mode == GpioMode::GPIO_OUTPUT) {
-            pinMode(pin, OUTPUT);
+            *ddr |= location.mask;
         } else if (mode == GpioMode::GPIO_INPUT_PULLUP) {
-            pinMode(pin, INPUT_PULLUP);
+            *ddr &= ~location.mask;
+            *out |= location.mask;
         } else if (mode == GpioMode::GPIO_INPUT) {
-            pinMode(pin, INPUT);
+            *ddr &= ~location.mask;
+            *out &= ~location.mask;
         }
+        SREG = oldSREG;
     }
-}
\ No newline at end of file
+}
@@ -1,12 +1,13 @@
 #include "input/NunchukInput.hpp"
 
 #include "gpio.hpp"
+#include "timebase.hpp"
 
 #include <ArduinoNunchuk.hpp>
 #include <Wire.h>
 
 NunchukInput::NunchukInput(int detect_pin) {
-    delay(50);
+    timebase::wait_us(50000);
 
     if (detect_pin > -1) {
         gpio::init_pin(detect_pin, gpio::GpioMode::GPIO_INPUT_PULLUP);
@@ -0,0 +1,88 @@
+#include "timebase.hpp"
+
+#include "stdlib.hpp"
+
+static_assert(64 % (F_CPU / 1000000) == 0, "Timer1 ticks must be a whole number of microseconds");
+
+namespace {
+    volatile uint32_t overflows = 0;
+
+    timebase::AlarmCallback alarm_callback = nullptr;
+    void *alarm_context = nullptr;
+
+    // Timer1 ticks since boot, as the overflow count and the current count. Must be called with
+    // interrupts disabled.
+    inline void read_ticks(uint32_t &high, uint16_t &low) {
+        low = TCNT1;
+        high = overflows;
+        // Account for an overflow whose interrupt hasn't been serviced yet.
+        if ((TIFR1 & _BV(TOV1)) && low < 0x8000) {
+            high++;
+        }
+    }
+}
+
+ISR(TIMER1_OVF_vect) {
+    overflows++;
+}
+
+ISR(TIMER1_COMPA_vect) {
+    TIMSK1 &= ~_BV(OCIE1A);
+    alarm_callback(alarm_context);
+}
+
+// Runs after the Arduino core's init(), which sets Timer1 up for PWM, and before setup(). Timer1 is
+// switched to a free running counter at 64 cycles per tick instead.
+void initVariant() {
+    TCCR1A = 0;
+    TCCR1B = _BV(CS11) | _BV(CS10);
+    TCNT1 = 0;
+    TIFR1 = _BV(TOV1);
+    TIMSK1 = _BV(TOIE1);
+}
+
+namespace timebase {
+    uint32_t now_us() {
+        uint8_t sreg = SREG;
+        cli();
+        uint32_t high;
+        uint16_t low;
+        read_ticks(high, low);
+        SREG = sreg;
+        return ((high << 16) | low) * us_per_tick;
+    }
+
+    uint64_t now_us64() {
+        uint8_t sreg = SREG;
+        cli();
+        uint32_t high;
+        uint16_t low;
+        read_ticks(high, low);
+        SREG = sreg;
+        return (((uint64_t)high << 16) | low) * us_per_tick;
+    }
+
+    bool schedule_alarm(uint32_t deadline_us, AlarmCallback callback, void *context) {
+        uint8_t sreg = SREG;
+        cli();
+        TIMSK1 &= ~_BV(OCIE1A);
+
+        int32_t remaining = deadline_us - now_us();
+        if (remaining <= 0 || (uint32_t)remaining / us_per_tick > 0xFFFF) {
+            SREG = sreg;
+            return false;
+        }
+
+        alarm_callback = callback;
+        alarm_context = context;
+        OCR1A = TCNT1 + remaining / us_per_tick;
+        TIFR1 = _BV(OCF1A);
+        TIMSK1 |= _BV(OCIE1A);
+        SREG = sreg;
+        return true;
+    }
+
+    void cancel_alarm() {
+        TIMSK1 &= ~_BV(OCIE1A);
+    }
+}
@@ -0,0 +1,68 @@
+#ifndef _NATIVE_ADAFRUIT_TINYUSB_H
+#define _NATIVE_ADAFRUIT_TINYUSB_H
+
+/*
+ * Stand-in for the subset of Adafruit TinyUSB used by HayBox. The simulated device is always
+ * mounted, and its HID endpoints are ready once per USB poll interval, see simulation.hpp.
+ */
+
+#include "stdlib.hpp"
+
+class Adafruit_USBD_Device {
+  public:
+    bool mounted() {
+        return true;
+    }
+    void setID(uint16_t vid, uint16_t pid) {}
+};
+
+extern Adafruit_USBD_Device USBDevice;
+#define TinyUSBDevice USBDevice
+
+// There's no USB stack to run, but it's called in spin loops, so let virtual time move on.
+inline void TinyUSB_Device_Task() {
+    tight_loop_contents();
+}
+
+// Keyboard usage IDs from the HID usage tables.
+enum {
+    HID_KEY_NONE = 0x00,
+    HID_KEY_A = 0x04,
+    HID_KEY_B,
+    HID_KEY_C,
+    HID_KEY_D,
+    HID_KEY_E,
+    HID_KEY_F,
+    HID_KEY_G,
+    HID_KEY_H,
+    HID_KEY_I,
+    HID_KEY_J,
+    HID_KEY_K,
+    HID_KEY_L,
+    HID_KEY_M,
+    HID_KEY_N,
+    HID_KEY_O,
+    HID_KEY_P,
+    HID_KEY_Q,
+    HID_KEY_R,
+    HID_KEY_S,
+    HID_KEY_T,
+    HID_KEY_U,
+    HID_KEY_V,
+    HID_KEY_W,
+    HID_KEY_X,
+    HID_KEY_Y,
+    HID_KEY_Z,
+};
+
+// An HID endpoint that the host reads once per poll interval, a fixed time into the frame.
+class NativeHidEndpoint {
+  public:
+    bool ready();
+    void sent();
+
+  private:
+    uint32_t _next_poll_us = 0;
+};
+
+#endif
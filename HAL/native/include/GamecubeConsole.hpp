@@ -0,0 +1,31 @@
+#ifndef _NATIVE_GAMECUBECONSOLE_HPP
+#define _NATIVE_GAMECUBECONSOLE_HPP
+
+#include "gamecube_definitions.h"
+
+#include <hardware/pio.h>
+
+/*
+ * Stand-in for joybus-pio's GamecubeConsole. Rather than listening on a data line, it simulates a
+ * console that polls at a fixed interval, and blocks for as long as the real transfers would take
+ * on the wire. See simulation.hpp for how the simulated console is configured.
+ */
+
+enum class PollStatus {
+    RUMBLE_OFF,
+    RUMBLE_ON,
+    ERROR,
+};
+
+class GamecubeConsole {
+  public:
+    GamecubeConsole(uint data_pin, PIO pio = pio0, int sm = -1, int offset = -1);
+    bool Detect();
+    void WaitForPoll();
+    void WaitForPollStart();
+    PollStatus WaitForPollEnd();
+    void SendReport(gc_report_t *report);
+    int GetOffset();
+};
+
+#endif
@@ -0,0 +1,18 @@
+#ifndef _NATIVE_N64CONSOLE_HPP
+#define _NATIVE_N64CONSOLE_HPP
+
+#include "n64_definitions.h"
+
+#include <hardware/pio.h>
+
+// Stand-in for joybus-pio's N64Console. Simulates a polling console like GamecubeConsole does.
+class N64Console {
+  public:
+    N64Console(uint data_pin, PIO pio = pio0, int sm = -1, int offset = -1);
+    bool Detect();
+    void WaitForPoll();
+    void SendReport(n64_report_t *report);
+    int GetOffset();
+};
+
+#endif
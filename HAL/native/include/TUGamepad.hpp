@@ -0,0 +1,32 @@
+#ifndef _NATIVE_TUGAMEPAD_HPP
+#define _NATIVE_TUGAMEPAD_HPP
+
+#include <Adafruit_TinyUSB.h>
+
+// Stand-in for TUGamepad. Reports are built as usual and then discarded when sent.
+class TUGamepad {
+  public:
+    static void registerDescriptor() {}
+
+    void begin() {}
+    bool ready() {
+        return _endpoint.ready();
+    }
+    void resetInputs() {}
+    void setButton(uint8_t button, bool pressed) {}
+    void leftXAxis(uint8_t value) {}
+    void leftYAxis(uint8_t value) {}
+    void rightXAxis(uint8_t value) {}
+    void rightYAxis(uint8_t value) {}
+    void triggerLAnalog(uint8_t value) {}
+    void triggerRAnalog(uint8_t value) {}
+    void hatSwitch(bool left, bool right, bool down, bool up) {}
+    void sendState() {
+        _endpoint.sent();
+    }
+
+  private:
+    NativeHidEndpoint _endpoint;
+};
+
+#endif
@@ -0,0 +1,17 @@
+#ifndef _NATIVE_TUKEYBOARD_HPP
+#define _NATIVE_TUKEYBOARD_HPP
+
+#include <Adafruit_TinyUSB.h>
+
+// Stand-in for TUKeyboard. Key states are discarded when sent.
+class TUKeyboard {
+  public:
+    static void registerDescriptor() {}
+
+    void begin() {}
+    void setPressed(uint8_t keycode, bool pressed) {}
+    void releaseAll() {}
+    void sendState() {}
+};
+
+#endif
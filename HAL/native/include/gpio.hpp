@@ -0,0 +1,42 @@
+#ifndef _GPIO_HPP
+#define _GPIO_HPP
+
+#include "stdlib.hpp"
+
+/*
+ * Simulated GPIO with the same single 32-pin port as the RP2040. Inputs read their pull level
+ * unless a button press is being simulated on them, in which case they read low.
+ */
+
+namespace gpio {
+    enum class GpioMode {
+        GPIO_OUTPUT,
+        GPIO_INPUT,
+        GPIO_INPUT_PULLUP,
+        GPIO_INPUT_PULLDOWN,
+    };
+
+    void init_pin(uint pin, GpioMode mode);
+
+    bool read_digital(uint pin);
+
+    void write_digital(uint pin, bool value);
+
+    inline uint pin_port(uint pin) {
+        return 0;
+    }
+
+    inline uint32_t pin_mask(uint pin) {
+        return 1ul << pin;
+    }
+
+    constexpr size_t port_count = 1;
+
+    // Reads every port into levels, which must hold port_count entries.
+    void read_all_ports(uint32_t *levels);
+
+    // Simulates holding down (or letting go of) a button wired from the pin to ground.
+    void set_pressed(uint pin, bool pressed);
+}
+
+#endif
@@ -0,0 +1,13 @@
+#ifndef _NATIVE_HARDWARE_PIO_H
+#define _NATIVE_HARDWARE_PIO_H
+
+#include <pico/stdlib.h>
+
+// PIO blocks only identify which hardware the joybus stand-ins would use, so they are opaque.
+typedef struct pio_hw pio_hw_t;
+typedef pio_hw_t *PIO;
+
+#define pio0 ((PIO)nullptr)
+#define pio1 ((PIO)nullptr)
+
+#endif
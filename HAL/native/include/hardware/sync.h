@@ -0,0 +1,8 @@
+#ifndef _NATIVE_HARDWARE_SYNC_H
+#define _NATIVE_HARDWARE_SYNC_H
+
+#include <pico/stdlib.h>
+
+void __dmb();
+
+#endif
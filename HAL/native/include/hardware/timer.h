@@ -0,0 +1,6 @@
+#ifndef _NATIVE_HARDWARE_TIMER_H
+#define _NATIVE_HARDWARE_TIMER_H
+
+#include <pico/stdlib.h>
+
+#endif
@@ -0,0 +1,9 @@
+#ifndef _NATIVE_PICO_BOOTROM_H
+#define _NATIVE_PICO_BOOTROM_H
+
+#include <pico/stdlib.h>
+
+// There is no bootloader to reboot into, so this just ends the process.
+void reset_usb_boot(uint32_t usb_activity_gpio_pin_mask, uint32_t disable_interface_mask);
+
+#endif
@@ -0,0 +1,14 @@
+#ifndef _NATIVE_PICO_CRITICAL_SECTION_H
+#define _NATIVE_PICO_CRITICAL_SECTION_H
+
+#include <pico/stdlib.h>
+
+// The host build runs on a single thread, so there is nothing for critical sections to exclude.
+typedef struct {
+} critical_section_t;
+
+void critical_section_init(critical_section_t *crit_sec);
+void critical_section_enter_blocking(critical_section_t *crit_sec);
+void critical_section_exit(critical_section_t *crit_sec);
+
+#endif
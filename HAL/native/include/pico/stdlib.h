@@ -0,0 +1,31 @@
+#ifndef _NATIVE_PICO_STDLIB_H
+#define _NATIVE_PICO_STDLIB_H
+
+/*
+ * Stand-in for the subset of the Pico SDK used by HayBox and the RP2040 HAL sources shared with the
+ * native build. GPIO calls are routed to the simulated pins in gpio.hpp.
+ */
+
+#include <cstdint>
+
+typedef unsigned int uint;
+
+#define GPIO_IN false
+#define GPIO_OUT true
+
+#define PICO_DEFAULT_LED_PIN 25
+
+void gpio_init(uint gpio);
+void gpio_set_dir(uint gpio, bool out);
+void gpio_pull_up(uint gpio);
+void gpio_pull_down(uint gpio);
+bool gpio_get(uint gpio);
+uint32_t gpio_get_all();
+void gpio_put(uint gpio, bool value);
+
+void busy_wait_us(uint64_t delay_us);
+
+// Lets virtual time move on in spin loops, see timebase.hpp.
+void tight_loop_contents();
+
+#endif
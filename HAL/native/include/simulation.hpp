@@ -0,0 +1,43 @@
+#ifndef _NATIVE_SIMULATION_HPP
+#define _NATIVE_SIMULATION_HPP
+
+#include "stdlib.hpp"
+
+/*
+ * Settings of the simulated hardware, read from environment variables on first use:
+ *
+ * HAYBOX_CONSOLE          Console to simulate: gamecube (default), n64 or none. With none, USB
+ *                         backends are used and the host polls at USB full speed (1000 Hz).
+ * HAYBOX_POLL_INTERVAL_US Time between console polls. Defaults to one poll per 60 Hz frame.
+ * HAYBOX_INPUT_CHANGE_US  If set, randomly changes which buttons are held this often, so that the
+ *                         firmware sees realistic traffic. Buttons are otherwise never pressed.
+ * HAYBOX_INPUT_SEED       Seed for the random button presses, for repeatable runs.
+ * HAYBOX_VIRTUAL_TIME     If set to 1, runs against a virtual clock rather than the host's, see
+ *                         timebase.hpp.
+ */
+
+namespace simulation {
+    enum class Console {
+        GAMECUBE,
+        N64,
+        NONE,
+    };
+
+    Console console();
+    uint32_t poll_interval_us();
+    uint32_t input_change_us();
+    uint32_t input_seed();
+    bool virtual_time();
+
+    // Time between polls of a USB host, which is also the length of a USB frame.
+    constexpr uint32_t usb_poll_interval_us = 1000;
+    // Time into each frame at which the host reads interrupt endpoints.
+    constexpr uint32_t usb_read_offset_us = 300;
+
+    // Time the given number of joybus bits take on the wire, at 4us per bit.
+    constexpr uint32_t joybus_transfer_us(uint32_t bits) {
+        return bits * 4;
+    }
+}
+
+#endif
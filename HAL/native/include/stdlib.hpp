@@ -0,0 +1,13 @@
+#ifndef _HAL_STDLIB_HPP
+#define _HAL_STDLIB_HPP
+
+#include <Arduino.h>
+#include <pico/stdlib.h>
+
+// There is no flash on the host, see the Pico HAL for what these are for.
+#define RAM_FUNC(func_name) func_name
+#define RAM_DATA(group)
+
+#define memory_barrier() __sync_synchronize()
+
+#endif
@@ -0,0 +1,57 @@
+#ifndef _TIMEBASE_HPP
+#define _TIMEBASE_HPP
+
+#include "stdlib.hpp"
+
+/*
+ * Monotonic time in microseconds since boot, and waits/alarms against it. All timing code goes
+ * through here so that it can run against a simulated clock on the host. 32-bit times wrap around
+ * every ~71 minutes, so compare them by subtraction, as reached() does, rather than directly.
+ *
+ * On the host, time either follows the host's monotonic clock or is virtual (see simulation.hpp).
+ * Virtual time only moves when something waits, so computation takes no time at all and long
+ * sessions can be simulated much faster than real time, with identical results on every run.
+ * Alarms fire when time is read or waited on after their deadline, in the thread that did so.
+ */
+
+namespace timebase {
+    uint32_t now_us();
+
+    uint64_t now_us64();
+
+    inline bool reached(uint32_t deadline_us) {
+        return (int32_t)(now_us() - deadline_us) >= 0;
+    }
+
+    // Spins until the deadline, or jumps straight to it in virtual time. Returns whether there was
+    // any time left to wait.
+    bool wait_until(uint32_t deadline_us);
+
+    inline void wait_us(uint32_t duration_us) {
+        wait_until(now_us() + duration_us);
+    }
+
+    // There is nothing to gain from sleeping on the host, so this spins.
+    inline bool sleep_until(uint32_t deadline_us) {
+        return wait_until(deadline_us);
+    }
+
+    typedef void (*AlarmCallback)(void *context);
+
+    // Calls callback once the deadline is reached. There is a single alarm, so scheduling another
+    // replaces any that is pending. Returns false if the deadline has already passed, in which case
+    // nothing is scheduled.
+    bool schedule_alarm(uint32_t deadline_us, AlarmCallback callback, void *context);
+
+    void cancel_alarm();
+
+    // Host-only controls of the clock.
+    bool is_virtual();
+    // Moves virtual time forward, firing any alarm that falls due. Does nothing in real time.
+    void advance_us(uint32_t duration_us);
+    // Called on every iteration of a spin loop. In virtual time this advances the clock by 1us, so
+    // that loops polling for a condition that depends on time make progress.
+    void spin();
+}
+
+#endif
@@ -0,0 +1,122 @@
+#include "gpio.hpp"
+
+#include "simulation.hpp"
+#include "stdlib.hpp"
+#include "timebase.hpp"
+
+namespace {
+    uint32_t outputs = 0;
+    uint32_t output_levels = 0;
+    uint32_t pull_ups = 0;
+    uint32_t pressed = 0;
+
+    uint32_t random_state = 0;
+    uint32_t next_input_change_us = 0;
+
+    uint32_t xorshift32() {
+        random_state ^= random_state << 13;
+        random_state ^= random_state >> 17;
+        random_state ^= random_state << 5;
+        return random_state;
+    }
+
+    // Randomly changes which buttons are held, if enabled. Each button is held a quarter of the
+    // time.
+    void update_random_presses() {
+        uint32_t interval = simulation::input_change_us();
+        if (interval == 0) {
+            return;
+        }
+        uint32_t now = timebase::now_us();
+        if (random_state == 0) {
+            random_state = simulation::input_seed() | 1;
+            next_input_change_us = now + interval;
+            return;
+        }
+        if ((int32_t)(now - next_input_change_us) < 0) {
+            return;
+        }
+        next_input_change_us += interval;
+        pressed = xorshift32() & xorshift32();
+    }
+
+    uint32_t levels() {
+        update_random_presses();
+        return (outputs & output_levels) | (~outputs & pull_ups & ~pressed);
+    }
+}
+
+namespace gpio {
+    void init_pin(uint pin, GpioMode mode) {
+        gpio_init(pin);
+        if (mode == GpioMode::GPIO_OUTPUT) {
+            gpio_set_dir(pin, GPIO_OUT);
+            return;
+        }
+
+        gpio_set_dir(pin, GPIO_IN);
+        if (mode == GpioMode::GPIO_INPUT_PULLUP) {
+            gpio_pull_up(pin);
+        } else if (mode == GpioMode::GPIO_INPUT_PULLDOWN) {
+            gpio_pull_down(pin);
+        }
+    }
+
+    bool read_digital(uint pin) {
+        return levels() & pin_mask(pin);
+    }
+
+    void write_digital(uint pin, bool value) {
+        if (value) {
+            output_levels |= pin_mask(pin);
+        } else {
+            output_levels &= ~pin_mask(pin);
+        }
+    }
+
+    void read_all_ports(uint32_t *levels) {
+        levels[0] = ::levels();
+    }
+
+    void set_pressed(uint pin, bool pressed) {
+        if (pressed) {
+            ::pressed |= pin_mask(pin);
+        } else {
+            ::pressed &= ~pin_mask(pin);
+        }
+    }
+}
+
+void gpio_init(uint gpio) {
+    outputs &= ~gpio::pin_mask(gpio);
+    output_levels &= ~gpio::pin_mask(gpio);
+    pull_ups &= ~gpio::pin_mask(gpio);
+}
+
+void gpio_set_dir(uint gpio, bool out) {
+    if (out) {
+        outputs |= gpio::pin_mask(gpio);
+    } else {
+        outputs &= ~gpio::pin_mask(gpio);
+    }
+}
+
+void gpio_pull_up(uint gpio) {
+    pull_ups |= gpio::pin_mask(gpio);
+}
+
+void gpio_pull_down(uint gpio) {
+    pull_ups &= ~gpio::pin_mask(gpio);
+}
+
+bool gpio_get(uint gpio) {
+    return gpio::read_digital(gpio);
+}
+
+uint32_t gpio_get_all() {
+    return levels();
+}
+
+void gpio_put(uint gpio, bool value) {
+    gpio::write_digital(gpio, value);
+}
@@ -0,0 +1,92 @@
+#include "GamecubeConsole.hpp"
+#include "N64Console.hpp"
+#include "poll_capture.hpp"
+#include "simulation.hpp"
+#include "stdlib.hpp"
+#include "timebase.hpp"
+
+// Poll command lengths on the wire, including the stop bit.
+#define GC_POLL_BITS 25
+#define GC_REPORT_BITS 65
+#define N64_POLL_BITS 9
+#define N64_REPORT_BITS 33
+
+static uint32_t first_poll = 0;
+static bool started = false;
+
+// Start of the first poll that hasn't begun yet. Polls happen every poll interval, starting one
+// interval after the console is first waited on, regardless of whether anything responds in time.
+static uint32_t next_poll_start() {
+    uint32_t now = timebase::now_us();
+    uint32_t interval = simulation::poll_interval_us();
+    if (!started) {
+        first_poll = now + interval;
+        started = true;
+    }
+    if ((int32_t)(now - first_poll) <= 0) {
+        return first_poll;
+    }
+    return now + interval - (now - first_poll) % interval;
+}
+
+GamecubeConsole::GamecubeConsole(uint data_pin, PIO pio, int sm, int offset) {}
+
+bool GamecubeConsole::Detect() {
+    return simulation::console() == simulation::Console::GAMECUBE;
+}
+
+void GamecubeConsole::WaitForPoll() {
+    WaitForPollStart();
+    WaitForPollEnd();
+}
+
+void GamecubeConsole::WaitForPollStart() {
+    timebase::wait_until(next_poll_start());
+}
+
+PollStatus GamecubeConsole::WaitForPollEnd() {
+    timebase::wait_us(simulation::joybus_transfer_us(GC_POLL_BITS));
+    return PollStatus::RUMBLE_OFF;
+}
+
+void GamecubeConsole::SendReport(gc_report_t *report) {
+    timebase::wait_us(simulation::joybus_transfer_us(GC_REPORT_BITS));
+}
+
+int GamecubeConsole::GetOffset() {
+    return 0;
+}
+
+N64Console::N64Console(uint data_pin, PIO pio, int sm, int offset) {}
+
+bool N64Console::Detect() {
+    return simulation::console() == simulation::Console::N64;
+}
+
+void N64Console::WaitForPoll() {
+    timebase::wait_until(next_poll_start());
+    timebase::wait_us(simulation::joybus_transfer_us(N64_POLL_BITS));
+}
+
+void N64Console::SendReport(n64_report_t *report) {
+    timebase::wait_us(simulation::joybus_transfer_us(N64_REPORT_BITS));
+}
+
+int N64Console::GetOffset() {
+    return 0;
+}
+
+// Poll starts are known exactly, as the simulation decides them.
+namespace poll_capture {
+    bool begin(uint data_pin, PIO pio) {
+        return true;
+    }
+
+    uint32_t last_poll_us() {
+        uint32_t now = timebase::now_us();
+        if (!started || (int32_t)(now - first_poll) < 0) {
+            return 0;
+        }
+        return now - (now - first_poll) % simulation::poll_interval_us();
+    }
+}
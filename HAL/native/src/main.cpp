@@ -0,0 +1,20 @@
+#include "stdlib.hpp"
+
+// Defined by the board config.
+void setup();
+void loop();
+
+/*
+ * Entry point of the host build, standing in for the Arduino core's. Takes an optional number of
+ * loop() iterations to run, so that runs under a profiler end on their own. Runs forever otherwise.
+ */
+int main(int argc, char **argv) {
+    unsigned long iterations = argc > 1 ? strtoul(argv[1], nullptr, 10) : 0;
+
+    setup();
+    for (unsigned long i = 0; iterations == 0 || i < iterations; i++) {
+        loop();
+    }
+
+    return 0;
+}
@@ -0,0 +1,30 @@
+#include "serial.hpp"
+
+#include "stdlib.hpp"
+
+#include <cstdio>
+
+// Serial output goes to stdout.
+namespace serial {
+    void init(unsigned long baudrate) {}
+
+    void close() {
+        fflush(stdout);
+    }
+
+    void print(const char *string) {
+        fputs(string, stdout);
+    }
+
+    void write(uint8_t byte) {
+        putchar(byte);
+    }
+
+    void write(uint8_t *bytes, size_t len) {
+        fwrite(bytes, 1, len, stdout);
+    }
+
+    int available_for_write() {
+        return 64;
+    }
+}
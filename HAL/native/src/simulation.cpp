@@ -0,0 +1,49 @@
+#include "simulation.hpp"
+
+#include "stdlib.hpp"
+
+#include <cstring>
+
+static uint32_t env_uint(const char *name, uint32_t default_value) {
+    const char *value = getenv(name);
+    if (value == nullptr || *value == '\0') {
+        return default_value;
+    }
+    return strtoul(value, nullptr, 10);
+}
+
+namespace simulation {
+    Console console() {
+        static Console console = [] {
+            const char *value = getenv("HAYBOX_CONSOLE");
+            if (value == nullptr || strcmp(value, "gamecube") == 0) {
+                return Console::GAMECUBE;
+            }
+            if (strcmp(value, "n64") == 0) {
+                return Console::N64;
+            }
+            return Console::NONE;
+        }();
+        return console;
+    }
+
+    uint32_t poll_interval_us() {
+        static uint32_t interval = env_uint("HAYBOX_POLL_INTERVAL_US", 16667);
+        return interval;
+    }
+
+    uint32_t input_change_us() {
+        static uint32_t interval = env_uint("HAYBOX_INPUT_CHANGE_US", 0);
+        return interval;
+    }
+
+    uint32_t input_seed() {
+        static uint32_t seed = env_uint("HAYBOX_INPUT_SEED", 1);
+        return seed;
+    }
+
+    bool virtual_time() {
+        static bool virtual_time = env_uint("HAYBOX_VIRTUAL_TIME", 0) != 0;
+        return virtual_time;
+    }
+}
@@ -0,0 +1,48 @@
+#include "stdlib.hpp"
+
+#include "timebase.hpp"
+
+#include <hardware/sync.h>
+#include <pico/bootrom.h>
+#include <pico/critical_section.h>
+
+#include <cstdio>
+
+uint32_t micros() {
+    return timebase::now_us();
+}
+
+uint32_t millis() {
+    return timebase::now_us64() / 1000;
+}
+
+void delay(uint32_t ms) {
+    timebase::wait_us(ms * 1000);
+}
+
+void delayMicroseconds(uint32_t us) {
+    timebase::wait_us(us);
+}
+
+void busy_wait_us(uint64_t delay_us) {
+    timebase::wait_us(delay_us);
+}
+
+void tight_loop_contents() {
+    timebase::spin();
+}
+
+void __dmb() {
+    __sync_synchronize();
+}
+
+void critical_section_init(critical_section_t *crit_sec) {}
+
+void critical_section_enter_blocking(critical_section_t *crit_sec) {}
+
+void critical_section_exit(critical_section_t *crit_sec) {}
+
+void reset_usb_boot(uint32_t usb_activity_gpio_pin_mask, uint32_t disable_interface_mask) {
+    fputs("Reset to bootloader requested, exiting.\n", stderr);
+    exit(0);
+}
@@ -0,0 +1,111 @@
+#include "timebase.hpp"
+
+#include "simulation.hpp"
+#include "stdlib.hpp"
+
+#include <ctime>
+
+namespace {
+    uint64_t monotonic_us() {
+        timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        return (uint64_t)now.tv_sec * 1000000 + now.tv_nsec / 1000;
+    }
+
+    const uint64_t start_us = monotonic_us();
+    uint64_t virtual_us = 0;
+
+    bool alarm_pending = false;
+    uint64_t alarm_deadline = 0;
+    timebase::AlarmCallback alarm_callback = nullptr;
+    void *alarm_context = nullptr;
+
+    uint64_t current_us() {
+        return simulation::virtual_time() ? virtual_us : monotonic_us() - start_us;
+    }
+
+    void fire_alarm_if_due(uint64_t now) {
+        if (alarm_pending && now >= alarm_deadline) {
+            alarm_pending = false;
+            alarm_callback(alarm_context);
+        }
+    }
+
+    // Moves virtual time to the given time, stopping at the alarm deadline on the way if there is
+    // one so that the alarm sees the time it was scheduled for.
+    void advance_to(uint64_t time) {
+        while (alarm_pending && alarm_deadline <= time && alarm_deadline > virtual_us) {
+            virtual_us = alarm_deadline;
+            fire_alarm_if_due(virtual_us);
+        }
+        if (time > virtual_us) {
+            virtual_us = time;
+        }
+        fire_alarm_if_due(virtual_us);
+    }
+
+    // Converts a 32-bit deadline to the full time, assuming it's less than half the 32-bit range
+    // away.
+    uint64_t expand(uint64_t now, uint32_t deadline_us) {
+        return now + (int32_t)(deadline_us - (uint32_t)now);
+    }
+}
+
+namespace timebase {
+    uint32_t now_us() {
+        return now_us64();
+    }
+
+    uint64_t now_us64() {
+        uint64_t now = current_us();
+        fire_alarm_if_due(now);
+        return now;
+    }
+
+    bool wait_until(uint32_t deadline_us) {
+        uint64_t now = now_us64();
+        uint64_t deadline = expand(now, deadline_us);
+        if (deadline <= now) {
+            return false;
+        }
+        if (is_virtual()) {
+            advance_to(deadline);
+        } else {
+            while (now_us64() < deadline) {
+            }
+        }
+        return true;
+    }
+
+    bool schedule_alarm(uint32_t deadline_us, AlarmCallback callback, void *context) {
+        uint64_t now = current_us();
+        uint64_t deadline = expand(now, deadline_us);
+        alarm_pending = false;
+        if (deadline <= now) {
+            return false;
+        }
+        alarm_deadline = deadline;
+        alarm_callback = callback;
+        alarm_context = context;
+        alarm_pending = true;
+        return true;
+    }
+
+    void cancel_alarm() {
+        alarm_pending = false;
+    }
+
+    bool is_virtual() {
+        return simulation::virtual_time();
+    }
+
+    void advance_us(uint32_t duration_us) {
+        if (is_virtual()) {
+            advance_to(virtual_us + duration_us);
+        }
+    }
+
+    void spin() {
+        advance_us(1);
+    }
+}
@@ -0,0 +1,34 @@
+#include "simulation.hpp"
+#include "stdlib.hpp"
+#include "timebase.hpp"
+#include "usb_sof.hpp"
+
+#include <Adafruit_TinyUSB.h>
+
+Adafruit_USBD_Device USBDevice;
+
+bool NativeHidEndpoint::ready() {
+    return timebase::reached(_next_poll_us);
+}
+
+// The host picks up the report on its next poll, after which the endpoint is free again.
+void NativeHidEndpoint::sent() {
+    uint32_t now = timebase::now_us();
+    uint32_t offset = simulation::usb_read_offset_us;
+    uint32_t interval = simulation::usb_poll_interval_us;
+    _next_poll_us = now - (now + interval - offset) % interval + interval;
+}
+
+// Frames start every poll interval, from time 0.
+namespace usb_sof {
+    void begin() {}
+
+    bool active() {
+        return true;
+    }
+
+    uint32_t last_frame_us() {
+        uint32_t now = timebase::now_us();
+        return now - now % simulation::usb_poll_interval_us;
+    }
+}
@@ -1,8 +1,10 @@
 #ifndef _COMMS_DINPUTBACKEND_HPP
 #define _COMMS_DINPUTBACKEND_HPP
 
+#include "comms/UsbPollScheduler.hpp"
 #include "core/CommunicationBackend.hpp"
 #include "core/InputSource.hpp"
+#include "modes/MeleeLimits.hpp"
 #include "stdlib.hpp"
 
 #include <TUGamepad.hpp>
@@ -12,10 +14,17 @@ class DInputBackend : public CommunicationBackend {
     DInputBackend(InputSource **input_sources, size_t input_source_count, bool nerfOn);
     ~DInputBackend();
     void SendReport();
+    void SetGameMode(ControllerMode *gamemode);
+    // Time from the start of sampling inputs until the host read them, for the last report and
+    // the longest recent one.
+    uint32_t InputAge();
+    uint32_t WorstInputAge();
 
   private:
     TUGamepad *_gamepad;
     bool _nerfOn;
+    UsbPollScheduler _scheduler;
+    MeleeLimiter _limiter;
 };
 
 #endif
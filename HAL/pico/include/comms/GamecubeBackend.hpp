@@ -2,9 +2,13 @@
 #define _COMMS_GAMECUBEBACKEND_HPP
 
 #include "core/CommunicationBackend.hpp"
+#include "core/SampleScheduler.hpp"
+#include "core/Snapshot.hpp"
+#include "modes/MeleeLimits.hpp"
 
 #include <GamecubeConsole.hpp>
 #include <hardware/pio.h>
+#include <pico/critical_section.h>
 
 class GamecubeBackend : public CommunicationBackend {
   public:
@@ -19,12 +23,58 @@ class GamecubeBackend : public CommunicationBackend {
     );
     ~GamecubeBackend();
     void SendReport();
+    // Once this is called from the second core, it samples inputs and prepares the report there
+    // back to back, and SendReport() just sends the latest report when the console polls. That
+    // replaces the scheduled samples ahead of each poll, so the sample offset and rate no longer
+    // apply, and the nerfs see samples as often as the second core loops. Off unless a config
+    // calls it.
+    void PrepareNextReport();
+    // While the second core prepares reports, these are the inputs of its latest sample.
+    InputState &GetInputs();
+    void SetGameMode(ControllerMode *gamemode);
+    // Fixes how long before the end of each sample slot inputs are sampled, instead of measuring
+    // how long it takes to process a sample. 0 goes back to measuring it.
+    void SetSampleOffset(uint32_t offset_us);
+    // Sets how often inputs are sampled between polls for the nerfs, 1000Hz by default. It's
+    // lowered to what the platform can keep up with. 0 goes back to the default.
+    void SetSampleRate(uint32_t rate_hz);
+    // Polls that came before the report was ready, polls that went unanswered, and samples that
+    // were skipped so as not to hold up a poll, since startup.
+    uint32_t LatePolls();
+    uint32_t MissedPolls();
+    uint32_t SkippedSamples();
     int GetOffset();
 
   private:
     GamecubeConsole *_gamecube;
+    // Kept ready to send, and only repacked when the outputs change.
     gc_report_t _report;
+    OutputState _reported_outputs;
     bool _nerfOn;
+    SampleScheduler _scheduler;
+    MeleeLimiter _limiter;
+    // Whether poll starts are timestamped in hardware, and whether the last one was.
+    bool _poll_capture;
+    bool _poll_captured;
+    uint32_t _poll_start;
+    // Time the limiter was given for the last sample.
+    uint32_t _sample_time;
+
+    // The second core asks for the mode and limiter with its first PrepareNextReport() call, and
+    // this one hands them over at the start of the next loop. From then on, only the second core
+    // touches them, and mode changes are passed to it through _pending_gamemode.
+    volatile bool _background_requested;
+    volatile bool _background;
+    bool _gamemode_pending;
+    ControllerMode *_pending_gamemode;
+    // Guards the handover, the pending mode, and the report.
+    critical_section_t _lock;
+    // Inputs of each sample taken on the second core, as scanned, and the copy last read from them.
+    Snapshot<InputState> _sampled_inputs;
+    InputState _read_inputs;
+
+    uint32_t SampleTime(uint32_t sample_start);
+    void UpdateReport(const OutputState &outputs);
 };
 
 #endif
@@ -2,6 +2,7 @@
 #define _COMMS_N64BACKEND_HPP
 
 #include "core/CommunicationBackend.hpp"
+#include "core/SampleScheduler.hpp"
 
 #include <N64Console.hpp>
 #include <hardware/pio.h>
@@ -18,11 +19,24 @@ class N64Backend : public CommunicationBackend {
     );
     ~N64Backend();
     void SendReport();
+    void SetGameMode(ControllerMode *gamemode);
+    // Fixes how long before the poll inputs are sampled, instead of measuring how long it takes to
+    // process a sample. 0 goes back to measuring it.
+    void SetSampleOffset(uint32_t offset_us);
+    // Polls that came before the report was ready, polls that went unanswered, and samples that
+    // were skipped so as not to hold up a poll, since startup. The console library doesn't report
+    // invalid polls, so none are counted as unanswered.
+    uint32_t LatePolls();
+    uint32_t MissedPolls();
+    uint32_t SkippedSamples();
     int GetOffset();
 
   private:
     N64Console *_n64;
     n64_report_t _report;
+    SampleScheduler _scheduler;
+
+    void UpdateReport();
 };
 
 #endif
@@ -1,6 +1,7 @@
 #ifndef _COMMS_NINTENDOSWITCHBACKEND_HPP
 #define _COMMS_NINTENDOSWITCHBACKEND_HPP
 
+#include "comms/UsbPollScheduler.hpp"
 #include "core/CommunicationBackend.hpp"
 
 typedef enum {
@@ -47,12 +48,18 @@ class NintendoSwitchBackend : public CommunicationBackend {
     static void RegisterDescriptor();
 
     void SendReport();
+    void SetGameMode(ControllerMode *gamemode);
+    // Time from the start of sampling inputs until the host read them, for the last report and
+    // the longest recent one.
+    uint32_t InputAge();
+    uint32_t WorstInputAge();
 
   protected:
     static const uint8_t _report_id = 0;
     static uint8_t _descriptor[];
 
     switch_gamepad_report_t _report;
+    UsbPollScheduler _scheduler;
 
     static switch_gamepad_hat_t GetHatPosition(bool left, bool right, bool down, bool up);
 };
@@ -0,0 +1,64 @@
+#ifndef _COMMS_USBPOLLSCHEDULER_HPP
+#define _COMMS_USBPOLLSCHEDULER_HPP
+
+#include "core/SampleScheduler.hpp"
+#include "stdlib.hpp"
+
+/*
+ * Works out when a USB HID backend should sample inputs, so that each report is queued just before
+ * the host reads it. The host reads an interrupt IN endpoint every bInterval frames, at a point
+ * within the frame that depends on what else it has scheduled but rarely changes. The scheduler
+ * locks on to the start-of-frame timestamps of the frames in which reports are read, and the read
+ * offset within the frame is learned from when reports are picked up. Without start-of-frame
+ * timestamps, it locks on to the reads themselves.
+ *
+ * It also measures the input age at host read: the time from the start of the sample that went into
+ * a report until the host read that report.
+ */
+class UsbPollScheduler {
+  public:
+    // computation_time_us: default budget for the time from the start of a sample until its report
+    //     is queued, used until the budget is calibrated.
+    UsbPollScheduler(uint32_t computation_time_us);
+
+    // To be called once the host has picked up the previous report. waited is whether the caller
+    // was already waiting for that, in which case now_us is when it happened.
+    void StartLoop(uint32_t now_us, bool waited);
+
+    // Whether the scheduler has yet to lock on to the host's reads. While it hasn't, the caller
+    // should sample straight away.
+    bool Detecting();
+    // Time between the host's reads. Only meaningful once locked on.
+    uint32_t ReadInterval();
+    // Time by which the sample for the next report should start.
+    uint32_t SampleDeadline();
+    // Whether a sample started now would be queued before the host's next read.
+    bool SampleFitsBeforeRead(uint32_t now_us);
+
+    // To be called once a report has been queued, with the start time of its sample.
+    void RecordReportQueued(uint32_t sample_start_us, uint32_t now_us);
+    // To be called when the previous report is queued again because a sample wouldn't fit.
+    void RecordSkippedSample();
+    // Starts calibrating the computation time budget from scratch.
+    void ResetComputationTime();
+
+    // Input age of the last report the host read, and the longest recent one.
+    uint32_t InputAge();
+    uint32_t WorstInputAge();
+
+  private:
+    SampleScheduler _scheduler;
+
+    // Earliest recent time from the start of a frame until the host read the endpoint.
+    bool _read_offset_measured;
+    uint32_t _read_offset_us;
+    uint8_t _read_offset_decay_count;
+
+    bool _report_queued;
+    uint32_t _sample_start_us;
+    uint32_t _input_age_us;
+    uint32_t _worst_input_age_us;
+    uint8_t _input_age_decay_count;
+};
+
+#endif
@@ -1,8 +1,10 @@
 #ifndef _COMMS_XINPUTBACKEND_HPP
 #define _COMMS_XINPUTBACKEND_HPP
 
+#include "comms/UsbPollScheduler.hpp"
 #include "core/CommunicationBackend.hpp"
 #include "core/InputSource.hpp"
+#include "modes/MeleeLimits.hpp"
 #include "stdlib.hpp"
 
 #include <Adafruit_USBD_XInput.hpp>
@@ -12,11 +14,18 @@ class XInputBackend : public CommunicationBackend {
     XInputBackend(InputSource **input_sources, size_t input_source_count, bool nerfOn);
     ~XInputBackend();
     void SendReport();
+    void SetGameMode(ControllerMode *gamemode);
+    // Time from the start of sampling inputs until the host read them, for the last report and
+    // the longest recent one.
+    uint32_t InputAge();
+    uint32_t WorstInputAge();
 
   private:
     Adafruit_USBD_XInput *_xinput;
     xinput_report_t _report = {};
     bool _nerfOn;
+    UsbPollScheduler _scheduler;
+    MeleeLimiter _limiter;
 };
 
 #endif
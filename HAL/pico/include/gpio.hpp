@@ -20,6 +20,23 @@ namespace gpio {
     inline void write_digital(uint pin, bool value) {
         gpio_put(pin, value);
     }
+
+    // Bulk access. Every pin belongs to a port whose levels can all be read in a single access, so
+    // input sources can sample many pins at the same instant. The RP2040 has a single port.
+    inline uint pin_port(uint pin) {
+        return 0;
+    }
+
+    inline uint32_t pin_mask(uint pin) {
+        return 1ul << pin;
+    }
+
+    constexpr size_t port_count = 1;
+
+    // Reads every port into levels, which must hold port_count entries.
+    inline void read_all_ports(uint32_t *levels) {
+        levels[0] = gpio_get_all();
+    }
 }
 
 #endif
\ No newline at end of file
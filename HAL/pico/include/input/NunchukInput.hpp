@@ -2,19 +2,46 @@
 #define _INPUT_NUNCHUKINPUT_HPP
 
 #include "core/InputSource.hpp"
+#include "core/Snapshot.hpp"
 
 #include <ArduinoNunchuk.hpp>
 #include <Wire.h>
 
+typedef struct {
+    bool connected = false;
+    bool c = false;
+    bool z = false;
+    int8_t x = 0;
+    int8_t y = 0;
+} NunchukReading;
+
+/*
+ * Reading the Nunchuk over I2C is slow, so it's done by calling Poll() in a loop on the second
+ * core. UpdateInputs() only picks up the latest reading, so it's fast and can run on either core.
+ */
 class NunchukInput : public InputSource {
   public:
     NunchukInput(TwoWire &wire = Wire, int detect_pin = -1, int sda_pin = 4, int scl_pin = 5);
     ~NunchukInput();
     InputScanSpeed ScanSpeed();
     void UpdateInputs(InputState &inputs);
+    // Reads the Nunchuk. The first call sets it up, which takes a while.
+    void Poll();
+    // Whether a Nunchuk was found when it was set up.
+    bool Detected();
 
   protected:
     ArduinoNunchuk *_nunchuk;
+
+  private:
+    TwoWire &_wire;
+    int _detect_pin;
+    int _sda_pin;
+    int _scl_pin;
+    bool _initialized;
+    Snapshot<NunchukReading> _reading;
+
+    void Init();
 };
 
-#endif
\ No newline at end of file
+#endif
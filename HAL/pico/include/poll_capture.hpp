@@ -0,0 +1,24 @@
+#ifndef _POLL_CAPTURE_HPP
+#define _POLL_CAPTURE_HPP
+
+#include "stdlib.hpp"
+
+#include <hardware/pio.h>
+
+/*
+ * Timestamps of the polls a console sends on the joybus data line, taken in hardware when each
+ * poll starts, i.e. on the first falling edge after the line has been idle. Unlike times read
+ * once the poll has been picked up, they don't vary with what the firmware was doing.
+ */
+
+namespace poll_capture {
+    // Starts timestamping the commands on the given data pin, with a spare state machine of the
+    // given PIO and two spare DMA channels. Returns false if there aren't enough to spare. Does
+    // nothing but return true if already started.
+    bool begin(uint data_pin, PIO pio);
+
+    // Start time of the most recent command from the console.
+    uint32_t last_poll_us();
+}
+
+#endif
@@ -2,6 +2,16 @@
 #define _HAL_STDLIB_HPP
 
 #include <Arduino.h>
+#include <hardware/sync.h>
 #include <pico/stdlib.h>
 
-#endif
\ No newline at end of file
+// The input to report path runs from SRAM, so that flash cache misses can't stall it right before a
+// poll. RAM_FUNC wraps the name of a function definition and RAM_DATA marks constant data that it
+// reads.
+#define RAM_FUNC(func_name) __not_in_flash_func(func_name)
+#define RAM_DATA(group) __not_in_flash(group)
+
+// Makes memory accesses before it visible to the other core before any after it.
+#define memory_barrier() __dmb()
+
+#endif
@@ -0,0 +1,55 @@
+#ifndef _TIMEBASE_HPP
+#define _TIMEBASE_HPP
+
+#include "stdlib.hpp"
+
+/*
+ * Monotonic time in microseconds since boot, and waits/alarms against it. All timing code goes
+ * through here so that it can run against a simulated clock on the host. 32-bit times wrap around
+ * every ~71 minutes, so compare them by subtraction, as reached() does, rather than directly.
+ */
+
+namespace timebase {
+    inline uint32_t now_us() {
+        return time_us_32();
+    }
+
+    inline uint64_t now_us64() {
+        return time_us_64();
+    }
+
+    inline bool reached(uint32_t deadline_us) {
+        return (int32_t)(now_us() - deadline_us) >= 0;
+    }
+
+    // Spins until the deadline. Returns whether there was any time left to wait.
+    inline bool wait_until(uint32_t deadline_us) {
+        if (reached(deadline_us)) {
+            return false;
+        }
+        while (!reached(deadline_us)) {
+            tight_loop_contents();
+        }
+        return true;
+    }
+
+    inline void wait_us(uint32_t duration_us) {
+        wait_until(now_us() + duration_us);
+    }
+
+    // Waits until the deadline like wait_until(), but sleeps on the alarm for all but the last few
+    // microseconds so that the core is idle and the bus is free in the meantime. The wake-up
+    // latency is measured on every sleep to decide how early to wake. Replaces any pending alarm.
+    bool sleep_until(uint32_t deadline_us);
+
+    typedef void (*AlarmCallback)(void *context);
+
+    // Calls callback from interrupt context once the deadline is reached. There is a single alarm,
+    // so scheduling another replaces any that is pending. Returns false if the deadline has already
+    // passed, in which case nothing is scheduled.
+    bool schedule_alarm(uint32_t deadline_us, AlarmCallback callback, void *context);
+
+    void cancel_alarm();
+}
+
+#endif
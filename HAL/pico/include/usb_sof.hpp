@@ -0,0 +1,22 @@
+#ifndef _USB_SOF_HPP
+#define _USB_SOF_HPP
+
+#include "stdlib.hpp"
+
+/*
+ * Timestamps of the start-of-frame packets that a USB host sends at the start of every 1ms frame.
+ * They give a steady clock that USB backends can align to.
+ */
+
+namespace usb_sof {
+    // Starts timestamping frames. Does nothing if already started.
+    void begin();
+
+    // Whether frames are being timestamped, i.e. the host has started one in the last few ms.
+    bool active();
+
+    // Start time of the most recent frame.
+    uint32_t last_frame_us();
+}
+
+#endif
@@ -1,16 +1,21 @@
 #include "comms/GamecubeBackend.hpp"
 
 #include "core/InputSource.hpp"
-
-#include "modes/MeleeLimits.hpp"
+#include "poll_capture.hpp"
+#include "timebase.hpp"
 
 #include <GamecubeConsole.hpp>
 #include <hardware/pio.h>
 #include <hardware/timer.h>
 #include <hardware/gpio.h>
+#include <pico/critical_section.h>
 
 //#define TIMINGDEBUG
 
+// The poll is picked up once its first byte is in, so a captured start older than this belongs to
+// an earlier command.
+#define MAX_POLL_CAPTURE_AGE_US 200
+
 GamecubeBackend::GamecubeBackend(
     InputSource **input_sources,
     size_t input_source_count,
@@ -20,106 +25,82 @@ GamecubeBackend::GamecubeBackend(
     int sm,
     int offset
 )
-    : CommunicationBackend(input_sources, input_source_count) {
+    : CommunicationBackend(input_sources, input_source_count),
+      // Samples are kept at least the computation time apart, so the fastest sample loop only caps
+      // the sample rate, at 10kHz. The computation time and poll lead are calibrated, together
+      // they start out as 250us.
+      _scheduler(100, 150, 100) {
     _gamecube = new GamecubeConsole(data_pin, pio, sm, offset);
+    _poll_capture = poll_capture::begin(data_pin, pio);
+    _poll_captured = false;
+    _poll_start = 0;
+    _sample_time = 0;
     _report = default_gc_report;
     _nerfOn = nerfOn;
+    _background_requested = false;
+    _background = false;
+    _gamemode_pending = false;
+    _pending_gamemode = nullptr;
+    critical_section_init(&_lock);
 }
 
 GamecubeBackend::~GamecubeBackend() {
     delete _gamecube;
 }
 
-void GamecubeBackend::SendReport() {
+void RAM_FUNC(GamecubeBackend::SendReport)() {
     // Update slower inputs before we start waiting for poll.
     //ScanInputs(InputScanSpeed::SLOW);
     //ScanInputs(InputScanSpeed::MEDIUM);
     //This fork won't support slower inputs
 
-    static uint32_t minLoop = 16384;
-    static uint loopCount = 0;
-    static bool detect = true;//false means run
-    static uint sampleCount = 1;
-    static uint32_t sampleSpacing = 0;
-    static uint32_t oldSampleTime = 0;
-    static uint32_t newSampleTime = 0;
-    static uint32_t loopTime = 0;
-    //const uint fastestLoop = 950; //fastest possible loop for AVR
-    const uint fastestLoop = 450; //fastest possible loop for rp2040
-
-    oldSampleTime = newSampleTime;
-    //YOU CANNOT USE MICROS ON AVR
-    //You need to manually use the low level timers
-    newSampleTime = micros();
-    loopTime = newSampleTime - oldSampleTime;
-
-    if(detect) {
+    // With the start of the last poll captured in hardware, time the loop from that rather than
+    // from whenever it gets to run, so that the poll timing is tracked from exact edge times.
+    _scheduler.StartLoop(_poll_captured ? _poll_start : timebase::now_us());
+
+    // Hand the mode and limiter over to the second core once it asks for them. This is the only
+    // point where this core is done with them.
+    if (_background_requested && !_background) {
+        critical_section_enter_blocking(&_lock);
+        _background = true;
+        critical_section_exit(&_lock);
+    }
+
+    if (_background) {
+        // The second core keeps the report up to date, so there is nothing to do until the poll.
+    } else if(_scheduler.Detecting()) {
         //run loop time detection procedure
-#ifdef TIMINGDEBUG
-        gpio_put(1, loopCount%2 == 0);
-#endif
-        loopCount++;
-        if(loopCount > 5 && loopTime > 300) {//screen out implausibly fast samples; the limit is 2500 Hz (400 us)
-            minLoop = min(minLoop, loopTime);
-        }
-        if(loopCount >= 100) {
-            detect = false;
-            sampleCount = 1;
-            while(1000*sampleCount <= minLoop) {//we want [sampleCount] ms-spaced samples within the smallest possible loop
-                sampleCount++;
-            }
-            sampleSpacing = minLoop / sampleCount;
-            if(sampleSpacing < fastestLoop && sampleCount > 1) {
-                sampleCount--;
-                sampleSpacing = minLoop / sampleCount;
-            }
-        }
         // Make sure to respond while measuring.
         ScanInputs(InputScanSpeed::FAST);
 
         // Run gamemode logic.
         UpdateOutputs();
 
-        _report.a = _outputs.a;
-        _report.b = _outputs.b;
-        _report.x = _outputs.x;
-        _report.y = _outputs.y;
-        _report.z = _outputs.buttonR;
-        _report.l = _outputs.triggerLDigital;
-        _report.r = _outputs.triggerRDigital;
-        _report.start = _outputs.start;
-        _report.dpad_left = _outputs.dpadLeft | _outputs.select;
-        _report.dpad_right = _outputs.dpadRight | _outputs.home;
-        _report.dpad_down = _outputs.dpadDown;
-        _report.dpad_up = _outputs.dpadUp;
-
-        // Analog outputs
-        _report.stick_x = _outputs.leftStickX;
-        _report.stick_y = _outputs.leftStickY;
-        _report.cstick_x = _outputs.rightStickX;
-        _report.cstick_y = _outputs.rightStickY;
-        _report.l_analog = _outputs.triggerLAnalog;
-        _report.r_analog = _outputs.triggerRAnalog;
+        UpdateReport(_outputs);
     } else {
         //run the delay procedure based on samplespacing
         //in the stock arduino software, it samples 850 us after the end of the poll response
         //we want the last sample to begin [850 + extra computation time] before the beginning of the last poll to give room for the sample and the travel time+nerf computation
         //
-        for (uint i = 0; i < sampleCount; i++) {
+        // Only the last sample's report goes out, so the ones before it aren't packed.
+        OutputState sampleOutputs;
+        for (uint i = 0; i < _scheduler.SampleCount(); i++) {
 #ifdef TIMINGDEBUG
             gpio_put(1, 0);
 #endif
 
-            const int nerfTime = 0;
-            const int computationTime = 250 + nerfTime;//*_nerfOn;//us; depends on the platform.
-            const uint32_t targetTime = ((i+1)*sampleSpacing)-computationTime;
-            int count = 0;
-            while(micros() - newSampleTime < targetTime) {
-                count++;//do something?
-                //spinlock
+            [[maybe_unused]] const bool waited = timebase::sleep_until(_scheduler.SampleDeadline(i));
+            const uint32_t sampleStart = timebase::now_us();
+            // Rather than risk missing the poll, answer it with the report from the last sample.
+            if (!_scheduler.SampleFitsBeforePoll(sampleStart)) {
+                _scheduler.RecordSkippedSamples(_scheduler.SampleCount() - i);
+                if (i > 0) {
+                    UpdateReport(sampleOutputs);
+                }
+                break;
             }
 #ifdef TIMINGDEBUG
-            gpio_put(1, count>0);
+            gpio_put(1, waited);
 #endif
 
             ScanInputs(InputScanSpeed::FAST);
@@ -127,78 +108,182 @@ void GamecubeBackend::SendReport() {
             // Run gamemode logic.
             UpdateOutputs();
 
-            if(_gamemode->isMelee()) {
+            if(_gamemode != nullptr && _gamemode->isMelee()) {
                 //APPLY NERFS HERE
-                OutputState nerfedOutputs;
-                limitOutputs(sampleSpacing/4, _nerfOn ? AB_A : AB_B, _inputs, _outputs, nerfedOutputs);
-
-                // Digital outputs
-                _report.a = nerfedOutputs.a;
-                _report.b = nerfedOutputs.b;
-                _report.x = nerfedOutputs.x;
-                _report.y = nerfedOutputs.y;
-                _report.z = nerfedOutputs.buttonR;
-                _report.l = nerfedOutputs.triggerLDigital;
-                _report.r = nerfedOutputs.triggerRDigital;
-                _report.start = nerfedOutputs.start;
-                _report.dpad_left = nerfedOutputs.dpadLeft | nerfedOutputs.select;
-                _report.dpad_right = nerfedOutputs.dpadRight | nerfedOutputs.home;
-                _report.dpad_down = nerfedOutputs.dpadDown;
-                _report.dpad_up = nerfedOutputs.dpadUp;
-
-                // Analog outputs
-                _report.stick_x = nerfedOutputs.leftStickX;
-                _report.stick_y = nerfedOutputs.leftStickY;
-                _report.cstick_x = nerfedOutputs.rightStickX;
-                _report.cstick_y = nerfedOutputs.rightStickY;
-                _report.l_analog = nerfedOutputs.triggerLAnalog;
-                _report.r_analog = nerfedOutputs.triggerRAnalog;
+                _limiter.LimitOutputs(SampleTime(sampleStart), _nerfOn ? AB_A : AB_B, _inputs, _outputs, sampleOutputs);
             } else {
-                // Digital outputs
-                _report.a = _outputs.a;
-                _report.b = _outputs.b;
-                _report.x = _outputs.x;
-                _report.y = _outputs.y;
-                _report.z = _outputs.buttonR;
-                _report.l = _outputs.triggerLDigital;
-                _report.r = _outputs.triggerRDigital;
-                _report.start = _outputs.start;
-                _report.dpad_left = _outputs.dpadLeft | _outputs.select;
-                _report.dpad_right = _outputs.dpadRight | _outputs.home;
-                _report.dpad_down = _outputs.dpadDown;
-                _report.dpad_up = _outputs.dpadUp;
-
-                // Analog outputs
-                _report.stick_x = _outputs.leftStickX;
-                _report.stick_y = _outputs.leftStickY;
-                _report.cstick_x = _outputs.rightStickX;
-                _report.cstick_y = _outputs.rightStickY;
-                _report.l_analog = _outputs.triggerLAnalog;
-                _report.r_analog = _outputs.triggerRAnalog;
+                sampleOutputs = _outputs;
             }
-        }
-        if(loopTime > minLoop+(minLoop >> 1)) {//if the loop time is 50% longer than expected
-            detect = true;//stop scanning inputs briefly and re-measure timings
-            loopCount = 0;
-            sampleCount = 1;
-            sampleSpacing = 0;
-            oldSampleTime = 0;
-            newSampleTime = 0;
-            loopTime = 0;
+            if (i == _scheduler.SampleCount() - 1) {
+                UpdateReport(sampleOutputs);
+            }
+
+            _scheduler.RecordComputationTime(timebase::now_us() - sampleStart);
         }
     }
 
+    _scheduler.StartWaitForPoll(timebase::now_us());
     _gamecube->WaitForPollStart();
+    _poll_start = timebase::now_us();
+    if (_poll_capture) {
+        const uint32_t captured = poll_capture::last_poll_us();
+        _poll_captured = _poll_start - captured < MAX_POLL_CAPTURE_AGE_US;
+        if (_poll_captured) {
+            _poll_start = captured;
+        }
+    }
+    _scheduler.RecordPollStart(_poll_start);
 #ifdef TIMINGDEBUG
     gpio_put(1, 1);
 #endif
 
     // Send outputs to console unless poll command is invalid.
     if (_gamecube->WaitForPollEnd() != PollStatus::ERROR) {
-        _gamecube->SendReport(&_report);
+#ifdef TIMINGDEBUG
+        // Marks the end of the poll, to time the response against on the data line.
+        gpio_put(1, 0);
+#endif
+        critical_section_enter_blocking(&_lock);
+        gc_report_t report = _report;
+        critical_section_exit(&_lock);
+        _gamecube->SendReport(&report);
+    } else {
+        _scheduler.RecordMissedPoll();
+    }
+}
+
+void RAM_FUNC(GamecubeBackend::PrepareNextReport)() {
+    critical_section_enter_blocking(&_lock);
+    const bool background = _background;
+    const bool gamemode_pending = _gamemode_pending;
+    ControllerMode *gamemode = _pending_gamemode;
+    _background_requested = true;
+    _gamemode_pending = false;
+    critical_section_exit(&_lock);
+
+    // Wait for the first core to finish the loop it may be in.
+    if (!background) {
+        return;
+    }
+    if (gamemode_pending) {
+        CommunicationBackend::SetGameMode(gamemode);
+        _limiter.Reset();
+    }
+
+    const uint32_t sampleStart = timebase::now_us();
+    ScanInputs(InputScanSpeed::FAST);
+    _sampled_inputs.Publish(_inputs);
+
+    // Run gamemode logic.
+    UpdateOutputs();
+
+    if(_gamemode != nullptr && _gamemode->isMelee()) {
+        OutputState nerfedOutputs;
+        _limiter.LimitOutputs(SampleTime(sampleStart), _nerfOn ? AB_A : AB_B, _inputs, _outputs, nerfedOutputs);
+        UpdateReport(nerfedOutputs);
+    } else {
+        UpdateReport(_outputs);
     }
 }
 
+InputState &GamecubeBackend::GetInputs() {
+    if (!_background) {
+        return _inputs;
+    }
+    _read_inputs = _sampled_inputs.Read();
+    return _read_inputs;
+}
+
+uint32_t RAM_FUNC(GamecubeBackend::SampleTime)(uint32_t sample_start) {
+    // Buttons that are scanned continuously have been the way they are read since they last
+    // changed. If that was after the last sample, these inputs were as good as sampled then, which
+    // times the change for the nerfs more closely than the sample that first sees it.
+    if (_inputs.change_timed && (int32_t)(_inputs.changed_us - _sample_time) > 0 &&
+        (int32_t)(sample_start - _inputs.changed_us) >= 0) {
+        _sample_time = _inputs.changed_us;
+    } else {
+        _sample_time = sample_start;
+    }
+    return _sample_time;
+}
+
+void RAM_FUNC(GamecubeBackend::UpdateReport)(const OutputState &outputs) {
+    // Most samples come out the same as the last, and then the report that is ready to go already
+    // says the same thing.
+    if (same_outputs(outputs, _reported_outputs)) {
+        return;
+    }
+    _reported_outputs = outputs;
+
+    gc_report_t report = _report;
+
+    // Digital outputs
+    report.a = outputs.a;
+    report.b = outputs.b;
+    report.x = outputs.x;
+    report.y = outputs.y;
+    report.z = outputs.buttonR;
+    report.l = outputs.triggerLDigital;
+    report.r = outputs.triggerRDigital;
+    report.start = outputs.start;
+    report.dpad_left = outputs.dpadLeft | outputs.select;
+    report.dpad_right = outputs.dpadRight | outputs.home;
+    report.dpad_down = outputs.dpadDown;
+    report.dpad_up = outputs.dpadUp;
+
+    // Analog outputs
+    report.stick_x = outputs.leftStickX;
+    report.stick_y = outputs.leftStickY;
+    report.cstick_x = outputs.rightStickX;
+    report.cstick_y = outputs.rightStickY;
+    report.l_analog = outputs.triggerLAnalog;
+    report.r_analog = outputs.triggerRAnalog;
+
+    critical_section_enter_blocking(&_lock);
+    _report = report;
+    critical_section_exit(&_lock);
+}
+
+void GamecubeBackend::SetGameMode(ControllerMode *gamemode) {
+    // Modes differ in how long they take to process a sample.
+    _scheduler.ResetComputationTime();
+
+    if (!_background) {
+        CommunicationBackend::SetGameMode(gamemode);
+        _limiter.Reset();
+        return;
+    }
+
+    // The second core owns the mode, so leave the new one for it to pick up. One that it hasn't
+    // picked up yet is replaced.
+    critical_section_enter_blocking(&_lock);
+    ControllerMode *replaced = _gamemode_pending ? _pending_gamemode : nullptr;
+    _pending_gamemode = gamemode;
+    _gamemode_pending = true;
+    critical_section_exit(&_lock);
+    delete replaced;
+}
+
+void GamecubeBackend::SetSampleOffset(uint32_t offset_us) {
+    _scheduler.SetSampleOffset(offset_us);
+}
+
+void GamecubeBackend::SetSampleRate(uint32_t rate_hz) {
+    _scheduler.SetSampleInterval(rate_hz > 0 ? 1000000 / rate_hz : 0);
+}
+
+uint32_t GamecubeBackend::LatePolls() {
+    return _scheduler.LatePolls();
+}
+
+uint32_t GamecubeBackend::MissedPolls() {
+    return _scheduler.MissedPolls();
+}
+
+uint32_t GamecubeBackend::SkippedSamples() {
+    return _scheduler.SkippedSamples();
+}
+
 int GamecubeBackend::GetOffset() {
     return _gamecube->GetOffset();
 }
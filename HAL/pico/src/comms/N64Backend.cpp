@@ -1,10 +1,15 @@
 #include "comms/N64Backend.hpp"
 
 #include "core/InputSource.hpp"
+#include "timebase.hpp"
 
 #include <N64Console.hpp>
 #include <hardware/pio.h>
 
+// WaitForPoll() returns once the poll command has been received: 8 bits plus a stop bit, at 4us
+// per bit.
+#define POLL_COMMAND_US 36
+
 N64Backend::N64Backend(
     InputSource **input_sources,
     size_t input_source_count,
@@ -13,7 +18,10 @@ N64Backend::N64Backend(
     int sm,
     int offset
 )
-    : CommunicationBackend(input_sources, input_source_count) {
+    : CommunicationBackend(input_sources, input_source_count),
+      // Without nerfs to run there's no use in sampling more than once per poll. The computation
+      // time and poll lead are calibrated, together they start out as 250us.
+      _scheduler(450, 150, 100, 1) {
     _n64 = new N64Console(data_pin, pio, sm, offset);
     _report = default_n64_report;
 }
@@ -22,20 +30,49 @@ N64Backend::~N64Backend() {
     delete _n64;
 }
 
-void N64Backend::SendReport() {
+void RAM_FUNC(N64Backend::SendReport)() {
+    _scheduler.StartLoop(timebase::now_us());
+
     // Update slower inputs before we start waiting for poll.
     ScanInputs(InputScanSpeed::SLOW);
     ScanInputs(InputScanSpeed::MEDIUM);
 
-    // Read inputs
-    _n64->WaitForPoll();
+    if (_scheduler.Detecting()) {
+        // Make sure to respond while measuring.
+        ScanInputs(InputScanSpeed::FAST);
+
+        // Run gamemode logic.
+        UpdateOutputs();
+
+        UpdateReport();
+    } else {
+        // Sample as late as possible before the next poll.
+        timebase::sleep_until(_scheduler.SampleDeadline(0));
+        const uint32_t sampleStart = timebase::now_us();
+        // Rather than risk missing the poll, answer it with the previous report.
+        if (_scheduler.SampleFitsBeforePoll(sampleStart)) {
+            ScanInputs(InputScanSpeed::FAST);
+
+            // Run gamemode logic.
+            UpdateOutputs();
 
-    // Update fast inputs in response to poll.
-    ScanInputs(InputScanSpeed::FAST);
+            UpdateReport();
 
-    // Run gamemode logic.
-    UpdateOutputs();
+            _scheduler.RecordComputationTime(timebase::now_us() - sampleStart);
+        } else {
+            _scheduler.RecordSkippedSamples(1);
+        }
+    }
+
+    _scheduler.StartWaitForPoll(timebase::now_us());
+    _n64->WaitForPoll();
+    _scheduler.RecordPollStart(timebase::now_us() - POLL_COMMAND_US);
+
+    // Send outputs to console.
+    _n64->SendReport(&_report);
+}
 
+void RAM_FUNC(N64Backend::UpdateReport)() {
     // Digital outputs
     _report.a = _outputs.a;
     _report.b = _outputs.b;
@@ -56,9 +93,28 @@ void N64Backend::SendReport() {
     // Analog outputs
     _report.stick_x = _outputs.leftStickX - 128;
     _report.stick_y = _outputs.leftStickY - 128;
+}
 
-    // Send outputs to console.
-    _n64->SendReport(&_report);
+void N64Backend::SetGameMode(ControllerMode *gamemode) {
+    CommunicationBackend::SetGameMode(gamemode);
+    // Modes differ in how long they take to process a sample.
+    _scheduler.ResetComputationTime();
+}
+
+void N64Backend::SetSampleOffset(uint32_t offset_us) {
+    _scheduler.SetSampleOffset(offset_us);
+}
+
+uint32_t N64Backend::LatePolls() {
+    return _scheduler.LatePolls();
+}
+
+uint32_t N64Backend::MissedPolls() {
+    return _scheduler.MissedPolls();
+}
+
+uint32_t N64Backend::SkippedSamples() {
+    return _scheduler.SkippedSamples();
 }
 
 int N64Backend::GetOffset() {
@@ -2,6 +2,7 @@
 
 #include "core/CommunicationBackend.hpp"
 #include "core/state.hpp"
+#include "timebase.hpp"
 
 #include <Adafruit_TinyUSB.h>
 #include <TUCompositeHID.hpp>
@@ -60,7 +61,9 @@
 uint8_t NintendoSwitchBackend::_descriptor[] = { HID_REPORT_DESC() };
 
 NintendoSwitchBackend::NintendoSwitchBackend(InputSource **input_sources, size_t input_source_count)
-    : CommunicationBackend(input_sources, input_source_count) {
+    : CommunicationBackend(input_sources, input_source_count),
+      // The computation time is calibrated, but starts out as 250us.
+      _scheduler(250) {
     USBDevice.setManufacturerDescriptor("HORI CO.,LTD.");
     USBDevice.setProductDescriptor("POKKEN CONTROLLER");
     USBDevice.setSerialDescriptor("1.0");
@@ -100,11 +103,30 @@ void NintendoSwitchBackend::RegisterDescriptor() {
 }
 
 void NintendoSwitchBackend::SendReport() {
+    // Wait for the host to pick up the previous report. Running the USB task here rather than
+    // leaving it to the background task means that's noticed as soon as it happens.
+    bool waited = false;
+    while (!TUCompositeHID::_usb_hid.ready()) {
+        TinyUSB_Device_Task();
+        waited = true;
+    }
+
+    _scheduler.StartLoop(timebase::now_us(), waited);
+
+    // Update slower inputs while there's time to spare.
     ScanInputs(InputScanSpeed::SLOW);
     ScanInputs(InputScanSpeed::MEDIUM);
 
-    while (!TUCompositeHID::_usb_hid.ready()) {
-        tight_loop_contents();
+    if (!_scheduler.Detecting()) {
+        // Sample as late as possible before the host's next read.
+        timebase::sleep_until(_scheduler.SampleDeadline());
+    }
+    const uint32_t sampleStart = timebase::now_us();
+    // Rather than risk missing the read, queue the previous report again.
+    if (!_scheduler.SampleFitsBeforeRead(sampleStart)) {
+        _scheduler.RecordSkippedSample();
+        TUCompositeHID::_usb_hid.sendReport(_report_id, &_report, sizeof(switch_gamepad_report_t));
+        return;
     }
 
     ScanInputs(InputScanSpeed::FAST);
@@ -137,6 +159,21 @@ void NintendoSwitchBackend::SendReport() {
         GetHatPosition(_outputs.dpadLeft, _outputs.dpadRight, _outputs.dpadDown, _outputs.dpadUp);
 
     TUCompositeHID::_usb_hid.sendReport(_report_id, &_report, sizeof(switch_gamepad_report_t));
+    _scheduler.RecordReportQueued(sampleStart, timebase::now_us());
+}
+
+void NintendoSwitchBackend::SetGameMode(ControllerMode *gamemode) {
+    CommunicationBackend::SetGameMode(gamemode);
+    // Modes differ in how long they take to process a sample.
+    _scheduler.ResetComputationTime();
+}
+
+uint32_t NintendoSwitchBackend::InputAge() {
+    return _scheduler.InputAge();
+}
+
+uint32_t NintendoSwitchBackend::WorstInputAge() {
+    return _scheduler.WorstInputAge();
 }
 
 switch_gamepad_hat_t NintendoSwitchBackend::GetHatPosition(
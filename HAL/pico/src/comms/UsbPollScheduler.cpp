@@ -0,0 +1,95 @@
+#include "comms/UsbPollScheduler.hpp"
+
+#include "stdlib.hpp"
+#include "usb_sof.hpp"
+
+UsbPollScheduler::UsbPollScheduler(uint32_t computation_time_us)
+    // Reports are read at most once per frame, so a single sample per report is enough. 450us is
+    // the fastest sample loop on rp2040. Loops start when a report is read, or at the start of its
+    // frame, so there's no poll lead.
+    : _scheduler(450, computation_time_us, 0, 1) {
+    _read_offset_measured = false;
+    _read_offset_us = 0;
+    _read_offset_decay_count = 0;
+    _report_queued = false;
+    _sample_start_us = 0;
+    _input_age_us = 0;
+    _worst_input_age_us = 0;
+    _input_age_decay_count = 0;
+    usb_sof::begin();
+}
+
+void RAM_FUNC(UsbPollScheduler::StartLoop)(uint32_t now_us, bool waited) {
+    // Only once locked on, as until then reports may have been waiting for a while.
+    if (_report_queued && !_scheduler.Detecting()) {
+        _input_age_us = now_us - _sample_start_us;
+        // Follow the worst case up straight away, and back down by 1us every 256 reads.
+        if (_input_age_us >= _worst_input_age_us) {
+            _worst_input_age_us = _input_age_us;
+        } else if (++_input_age_decay_count == 0) {
+            _worst_input_age_us--;
+        }
+    }
+
+    if (!usb_sof::active()) {
+        _read_offset_measured = false;
+        _read_offset_us = 0;
+        _scheduler.StartLoop(now_us);
+        return;
+    }
+
+    // The host read the report in the frame that started last, unless it was picked up late.
+    const uint32_t frame_start = usb_sof::last_frame_us();
+    // Only once locked on, so that reads seen in the frame after the one they happened in, e.g. at
+    // startup, are ignored.
+    if (waited && !_scheduler.Detecting()) {
+        // Follow the read offset down straight away, and back up by 1us every 256 reads.
+        const uint32_t read_offset = now_us - frame_start;
+        if (!_read_offset_measured || read_offset <= _read_offset_us) {
+            _read_offset_us = read_offset;
+            _read_offset_measured = true;
+        } else if (++_read_offset_decay_count == 0) {
+            _read_offset_us++;
+        }
+    }
+    _scheduler.StartLoop(frame_start);
+}
+
+bool RAM_FUNC(UsbPollScheduler::Detecting)() {
+    return _scheduler.Detecting();
+}
+
+uint32_t RAM_FUNC(UsbPollScheduler::ReadInterval)() {
+    return _scheduler.SampleSpacing();
+}
+
+uint32_t RAM_FUNC(UsbPollScheduler::SampleDeadline)() {
+    return _scheduler.SampleDeadline(0) + _read_offset_us;
+}
+
+bool RAM_FUNC(UsbPollScheduler::SampleFitsBeforeRead)(uint32_t now_us) {
+    return _scheduler.SampleFitsBeforePoll(now_us - _read_offset_us);
+}
+
+void RAM_FUNC(UsbPollScheduler::RecordReportQueued)(uint32_t sample_start_us, uint32_t now_us) {
+    _scheduler.RecordComputationTime(now_us - sample_start_us);
+    _scheduler.StartWaitForPoll(now_us - _read_offset_us);
+    _report_queued = true;
+    _sample_start_us = sample_start_us;
+}
+
+void UsbPollScheduler::RecordSkippedSample() {
+    _scheduler.RecordSkippedSamples(1);
+}
+
+void UsbPollScheduler::ResetComputationTime() {
+    _scheduler.ResetComputationTime();
+}
+
+uint32_t UsbPollScheduler::InputAge() {
+    return _input_age_us;
+}
+
+uint32_t UsbPollScheduler::WorstInputAge() {
+    return _worst_input_age_us;
+}
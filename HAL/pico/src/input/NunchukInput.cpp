@@ -1,29 +1,41 @@
 #include "input/NunchukInput.hpp"
 
 #include "gpio.hpp"
+#include "timebase.hpp"
 
 #include <Wire.h>
 
-NunchukInput::NunchukInput(TwoWire &wire, int detect_pin, int sda_pin, int scl_pin) {
-    delay(50);
+NunchukInput::NunchukInput(TwoWire &wire, int detect_pin, int sda_pin, int scl_pin)
+    : _wire(wire) {
+    _nunchuk = nullptr;
+    _detect_pin = detect_pin;
+    _sda_pin = sda_pin;
+    _scl_pin = scl_pin;
+    _initialized = false;
+}
 
-    if (sda_pin < 0 || scl_pin < 0) {
-        _nunchuk = nullptr;
+NunchukInput::~NunchukInput() {
+    delete _nunchuk;
+}
+
+void NunchukInput::Init() {
+    timebase::wait_us(50000);
+
+    if (_sda_pin < 0 || _scl_pin < 0) {
         return;
     }
 
-    if (detect_pin > -1) {
-        gpio::init_pin(detect_pin, gpio::GpioMode::GPIO_INPUT_PULLUP);
-        if (gpio::read_digital(detect_pin)) {
-            _nunchuk = nullptr;
+    if (_detect_pin > -1) {
+        gpio::init_pin(_detect_pin, gpio::GpioMode::GPIO_INPUT_PULLUP);
+        if (gpio::read_digital(_detect_pin)) {
             return;
         }
     }
 
-    wire.setSDA(sda_pin);
-    wire.setSCL(scl_pin);
+    _wire.setSDA(_sda_pin);
+    _wire.setSCL(_scl_pin);
 
-    _nunchuk = new ArduinoNunchuk(wire);
+    _nunchuk = new ArduinoNunchuk(_wire);
 
     if (!_nunchuk->init() || !_nunchuk->update()) {
         // If a Nunchuk isn't connected we don't want i2c to stay enabled because it might interfere
@@ -34,20 +46,39 @@ NunchukInput::NunchukInput(TwoWire &wire, int detect_pin, int sda_pin, int scl_p
     }
 }
 
-NunchukInput::~NunchukInput() {
-    delete _nunchuk;
-}
-
 InputScanSpeed NunchukInput::ScanSpeed() {
-    return InputScanSpeed::SLOW;
+    // The slow part is done by Poll().
+    return InputScanSpeed::FAST;
 }
 
-void NunchukInput::UpdateInputs(InputState &inputs) {
+void NunchukInput::Poll() {
+    if (!_initialized) {
+        _initialized = true;
+        Init();
+    }
+
     if (_nunchuk != nullptr && _nunchuk->update()) {
+        NunchukReading reading;
+        reading.connected = true;
+        reading.x = _nunchuk->stickX();
+        reading.y = _nunchuk->stickY();
+        reading.c = _nunchuk->buttonC();
+        reading.z = _nunchuk->buttonZ();
+        _reading.Publish(reading);
+    }
+}
+
+bool NunchukInput::Detected() {
+    return _nunchuk != nullptr;
+}
+
+void RAM_FUNC(NunchukInput::UpdateInputs)(InputState &inputs) {
+    const NunchukReading reading = _reading.Read();
+    if (reading.connected) {
         inputs.nunchuk_connected = true;
-        inputs.nunchuk_x = _nunchuk->stickX();
-        inputs.nunchuk_y = _nunchuk->stickY();
-        inputs.nunchuk_c = _nunchuk->buttonC();
-        inputs.nunchuk_z = _nunchuk->buttonZ();
+        inputs.nunchuk_x = reading.x;
+        inputs.nunchuk_y = reading.y;
+        inputs.nunchuk_c = reading.c;
+        inputs.nunchuk_z = reading.z;
     }
 }
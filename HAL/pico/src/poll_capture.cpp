@@ -0,0 +1,112 @@
+#include "poll_capture.hpp"
+
+#include "stdlib.hpp"
+
+#include <hardware/clocks.h>
+#include <hardware/dma.h>
+#include <hardware/pio.h>
+#include <hardware/structs/timer.h>
+
+// The state machine runs at 8MHz, so edges are caught within 125ns.
+#define CAPTURE_CLOCK_HZ 8000000
+// Highs within a transfer last 3us at most, and the controller answers a few us after the console,
+// so a falling edge after 20us of high line starts a new command.
+#define IDLE_US 20
+
+namespace {
+    bool started = false;
+    volatile uint32_t poll_start_us = 0;
+    uint32_t discarded;
+
+    // Waits for the line to be high for IDLE_US, then pushes a word on the next falling edge. Each
+    // pass of the idle loop takes 8 cycles, or 1us. Jump targets are relative to the start of the
+    // program, which pio_add_program() relocates.
+    uint16_t program_instructions[6];
+
+    const pio_program_t program = {
+        .instructions = program_instructions,
+        .length = sizeof(program_instructions) / sizeof(program_instructions[0]),
+        .origin = -1,
+    };
+
+    void encode_program() {
+        program_instructions[0] = pio_encode_set(pio_x, IDLE_US - 1);
+        program_instructions[1] = pio_encode_jmp_pin(3);
+        program_instructions[2] = pio_encode_jmp(0);
+        program_instructions[3] = pio_encode_jmp_x_dec(1) | pio_encode_delay(6);
+        program_instructions[4] = pio_encode_wait_pin(false, 0);
+        program_instructions[5] = pio_encode_push(false, false);
+    }
+}
+
+namespace poll_capture {
+    bool begin(uint data_pin, PIO pio) {
+        if (started) {
+            return true;
+        }
+
+        encode_program();
+        if (!pio_can_add_program(pio, &program)) {
+            return false;
+        }
+        int sm = pio_claim_unused_sm(pio, false);
+        if (sm < 0) {
+            return false;
+        }
+        int pop_channel = dma_claim_unused_channel(false);
+        int stamp_channel = dma_claim_unused_channel(false);
+        if (pop_channel < 0 || stamp_channel < 0) {
+            if (pop_channel >= 0) {
+                dma_channel_unclaim(pop_channel);
+            }
+            if (stamp_channel >= 0) {
+                dma_channel_unclaim(stamp_channel);
+            }
+            pio_sm_unclaim(pio, sm);
+            return false;
+        }
+        uint offset = pio_add_program(pio, &program);
+
+        // The line stays under the joybus state machine's control, this one only reads it.
+        pio_sm_config config = pio_get_default_sm_config();
+        sm_config_set_wrap(&config, offset, offset + program.length - 1);
+        sm_config_set_in_pins(&config, data_pin);
+        sm_config_set_jmp_pin(&config, data_pin);
+        sm_config_set_clkdiv(&config, (float)clock_get_hz(clk_sys) / CAPTURE_CLOCK_HZ);
+        pio_sm_init(pio, sm, offset, &config);
+
+        // Each edge the state machine reports is popped by one channel, which then triggers the
+        // other to copy the timer into poll_start_us, which in turn rearms the first. No code runs
+        // in between, so the timestamp lands a fixed few cycles after the edge.
+        dma_channel_config pop_config = dma_channel_get_default_config(pop_channel);
+        channel_config_set_transfer_data_size(&pop_config, DMA_SIZE_32);
+        channel_config_set_read_increment(&pop_config, false);
+        channel_config_set_write_increment(&pop_config, false);
+        channel_config_set_dreq(&pop_config, pio_get_dreq(pio, sm, false));
+        channel_config_set_chain_to(&pop_config, stamp_channel);
+
+        dma_channel_config stamp_config = dma_channel_get_default_config(stamp_channel);
+        channel_config_set_transfer_data_size(&stamp_config, DMA_SIZE_32);
+        channel_config_set_read_increment(&stamp_config, false);
+        channel_config_set_write_increment(&stamp_config, false);
+        channel_config_set_chain_to(&stamp_config, pop_channel);
+
+        dma_channel_configure(
+            stamp_channel,
+            &stamp_config,
+            &poll_start_us,
+            &timer_hw->timerawl,
+            1,
+            false
+        );
+        dma_channel_configure(pop_channel, &pop_config, &discarded, &pio->rxf[sm], 1, true);
+
+        pio_sm_set_enabled(pio, sm, true);
+        started = true;
+        return true;
+    }
+
+    uint32_t RAM_FUNC(last_poll_us)() {
+        return poll_start_us;
+    }
+}
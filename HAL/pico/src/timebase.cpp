@@ -0,0 +1,86 @@
+#include "timebase.hpp"
+
+#include "stdlib.hpp"
+
+#include <hardware/sync.h>
+#include <pico/time.h>
+
+namespace {
+    volatile alarm_id_t alarm = 0;
+    timebase::AlarmCallback alarm_callback = nullptr;
+    void *alarm_context = nullptr;
+
+    int64_t on_alarm(alarm_id_t id, void *user_data) {
+        alarm = 0;
+        alarm_callback(alarm_context);
+        return 0;
+    }
+
+    // Wake-ups later than this are put down to other interrupts rather than to the alarm.
+    constexpr uint32_t max_wake_latency_us = 20;
+    // How long it takes from the alarm's deadline until a core sleeping on it is running again.
+    uint32_t wake_latency_us = 4;
+    volatile bool woken = false;
+    uint32_t sleep_count = 0;
+
+    void on_wake(void *context) {
+        woken = true;
+        __sev();
+    }
+}
+
+namespace timebase {
+    bool schedule_alarm(uint32_t deadline_us, AlarmCallback callback, void *context) {
+        cancel_alarm();
+
+        uint64_t now = now_us64();
+        int32_t remaining = deadline_us - (uint32_t)now;
+        if (remaining <= 0) {
+            return false;
+        }
+
+        alarm_callback = callback;
+        alarm_context = context;
+        alarm = add_alarm_at(from_us_since_boot(now + remaining), on_alarm, nullptr, false);
+        return alarm > 0;
+    }
+
+    bool RAM_FUNC(sleep_until)(uint32_t deadline_us) {
+        if (reached(deadline_us)) {
+            return false;
+        }
+
+        // Wake up a microsecond earlier than the latency alone calls for, then spin the rest.
+        uint32_t wake_time = deadline_us - wake_latency_us - 1;
+        woken = false;
+        if (schedule_alarm(wake_time, on_wake, nullptr)) {
+            // Any interrupt or event wakes the core, so sleep again until the alarm has fired.
+            while (!woken) {
+                __wfe();
+            }
+
+            // Follow the latency up straight away and back down slowly.
+            uint32_t latency = now_us() - wake_time;
+            if (latency > max_wake_latency_us) {
+                latency = max_wake_latency_us;
+            }
+            if (latency > wake_latency_us) {
+                wake_latency_us = latency;
+            } else if (latency < wake_latency_us && !(++sleep_count & 0x3F)) {
+                wake_latency_us--;
+            }
+        }
+
+        while (!reached(deadline_us)) {
+            tight_loop_contents();
+        }
+        return true;
+    }
+
+    void cancel_alarm() {
+        if (alarm > 0) {
+            ::cancel_alarm(alarm);
+            alarm = 0;
+        }
+    }
+}
@@ -0,0 +1,54 @@
+#include "usb_sof.hpp"
+
+#include "stdlib.hpp"
+#include "timebase.hpp"
+
+#include <hardware/irq.h>
+#include <hardware/regs/usb.h>
+#include <hardware/structs/usb.h>
+
+// Frames older than this mean the host has stopped sending them, e.g. because it suspended us.
+#define MAX_FRAME_AGE_US 3000
+
+namespace {
+    volatile bool started = false;
+    volatile bool frame_seen = false;
+    volatile uint32_t frame_number = 0;
+    volatile uint32_t frame_start_us = 0;
+
+    // Runs on every USB interrupt, after the device stack's own handler, which clears the start of
+    // frame flag. So rather than check for that, look for a new frame number.
+    void __not_in_flash_func(on_usb_irq)() {
+        uint32_t frame = usb_hw->sof_rd & USB_SOF_RD_BITS;
+        if (!frame_seen || frame != frame_number) {
+            frame_start_us = timebase::now_us();
+            frame_number = frame;
+            frame_seen = true;
+        }
+        // The device stack turns the start of frame interrupt off whenever it has no use for it.
+        hw_set_bits(&usb_hw->inte, USB_INTS_DEV_SOF_BITS);
+    }
+}
+
+namespace usb_sof {
+    void begin() {
+        if (started) {
+            return;
+        }
+        started = true;
+        irq_add_shared_handler(
+            USBCTRL_IRQ,
+            on_usb_irq,
+            PICO_SHARED_IRQ_HANDLER_LOWEST_ORDER_PRIORITY
+        );
+        hw_set_bits(&usb_hw->inte, USB_INTS_DEV_SOF_BITS);
+    }
+
+    bool active() {
+        return frame_seen && timebase::now_us() - frame_start_us < MAX_FRAME_AGE_US;
+    }
+
+    uint32_t last_frame_us() {
+        return frame_start_us;
+    }
+}
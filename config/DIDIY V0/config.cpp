@@ -16,39 +16,46 @@
 #include "joybus_utils.hpp"
 #include "modes/Melee20Button.hpp"
 #include "stdlib.hpp"
+#include "timebase.hpp"
 
 #include <pico/bootrom.h>
 
+// Uncomment to have the second core prepare GameCube reports continuously instead of sampling
+// inputs on a schedule ahead of each poll. It only does so while no Nunchuk is connected, as
+// reading one blocks the second core.
+//#define PREPARE_REPORTS_ON_CORE1
+
 CommunicationBackend **backends = nullptr;
 size_t backend_count;
+NunchukInput *nunchuk = nullptr;
 KeyboardMode *current_kb_mode = nullptr;
 
 GpioButtonMapping button_mappings[] = {
-    {&InputState::l,            5 },
-    { &InputState::left,        4 },
-    { &InputState::down,        3 },
-    { &InputState::right,       2 },
-
-    { &InputState::mod_x,       6 },
-    { &InputState::mod_y,       7 },
-
-    { &InputState::start,       0 },
-
-    { &InputState::c_left,      13},
-    { &InputState::c_up,        12},
-    { &InputState::c_down,      15},
-    { &InputState::a,           14},
-    { &InputState::c_right,     16},
-
-    { &InputState::b,           26},
-    { &InputState::x,           21},
-    { &InputState::z,           19},
-    { &InputState::up,          17},
-
-    { &InputState::r,           27},
-    { &InputState::y,           22},
-    { &InputState::lightshield, 20},
-    { &InputState::midshield,   18},
+    {InputBit::l,            5 },
+    { InputBit::left,        4 },
+    { InputBit::down,        3 },
+    { InputBit::right,       2 },
+
+    { InputBit::mod_x,       6 },
+    { InputBit::mod_y,       7 },
+
+    { InputBit::start,       0 },
+
+    { InputBit::c_left,      13},
+    { InputBit::c_up,        12},
+    { InputBit::c_down,      15},
+    { InputBit::a,           14},
+    { InputBit::c_right,     16},
+
+    { InputBit::b,           26},
+    { InputBit::x,           21},
+    { InputBit::z,           19},
+    { InputBit::up,          17},
+
+    { InputBit::r,           27},
+    { InputBit::y,           22},
+    { InputBit::lightshield, 20},
+    { InputBit::midshield,   18},
 };
 size_t button_count = sizeof(button_mappings) / sizeof(GpioButtonMapping);
 
@@ -77,8 +84,12 @@ void setup() {
     gpio_set_dir(PICO_DEFAULT_LED_PIN, GPIO_OUT);
     gpio_put(PICO_DEFAULT_LED_PIN, 1);
 
+    // Create Nunchuk input source. It's read on the second core, and its readings are picked up
+    // along with the other inputs.
+    nunchuk = new NunchukInput(Wire, pinout.nunchuk_detect, pinout.nunchuk_sda, pinout.nunchuk_scl);
+
     // Create array of input sources to be used.
-    static InputSource *input_sources[] = { gpio_input };
+    static InputSource *input_sources[] = { gpio_input, nunchuk };
     size_t input_source_count = sizeof(input_sources) / sizeof(InputSource *);
 
     ConnectedConsole console = detect_console(pinout.joybus_data);
@@ -154,21 +165,22 @@ void loop() {
     }
 }
 
-/* Nunchuk code runs on the second core */
-NunchukInput *nunchuk = nullptr;
-
+/* Nunchuk reads, and report preparation if enabled, run on the second core */
 void setup1() {
     while (backends == nullptr) {
         tight_loop_contents();
     }
-
-    // Create Nunchuk input source.
-    nunchuk = new NunchukInput(Wire, pinout.nunchuk_detect, pinout.nunchuk_sda, pinout.nunchuk_scl);
 }
 
 void loop1() {
     if (backends != nullptr) {
-        nunchuk->UpdateInputs(backends[0]->GetInputs());
-        busy_wait_us(50);
+        nunchuk->Poll();
+#ifdef PREPARE_REPORTS_ON_CORE1
+        // Keep the next report up to date until the Nunchuk is read again.
+        const uint32_t nunchuk_due = timebase::now_us() + 50;
+        while (!nunchuk->Detected() && !timebase::reached(nunchuk_due)) {
+            backends[0]->PrepareNextReport();
+        }
+#endif
     }
 }
@@ -16,41 +16,48 @@
 #include "joybus_utils.hpp"
 #include "modes/Melee20Button.hpp"
 #include "stdlib.hpp"
+#include "timebase.hpp"
 
 #include <pico/bootrom.h>
 
+// Uncomment to have the second core prepare GameCube reports continuously instead of sampling
+// inputs on a schedule ahead of each poll. It only does so while no Nunchuk is connected, as
+// reading one blocks the second core.
+//#define PREPARE_REPORTS_ON_CORE1
+
 CommunicationBackend **backends = nullptr;
 size_t backend_count;
+NunchukInput *nunchuk = nullptr;
 KeyboardMode *current_kb_mode = nullptr;
 
 GpioButtonMapping button_mappings[] = {
-    {&InputState::l,            15},
-    { &InputState::left,        14},
-    { &InputState::down,        13},
-    { &InputState::right,       12},
-
-    { &InputState::mod_x,       11},
-    { &InputState::mod_y,       10},
-
-    { &InputState::select,      20},
-    { &InputState::start,       21},
-    { &InputState::home,        19},
-
-    { &InputState::c_left,      22},
-    { &InputState::c_up,        7 },
-    { &InputState::c_down,      9 },
-    { &InputState::a,           8 },
-    { &InputState::c_right,     26},
-
-    { &InputState::b,           3 },
-    { &InputState::x,           2 },
-    { &InputState::z,           1 },
-    { &InputState::up,          0 },
-
-    { &InputState::r,           27},
-    { &InputState::y,           6 },
-    { &InputState::lightshield, 5 },
-    { &InputState::midshield,   4 },
+    {InputBit::l,            15},
+    { InputBit::left,        14},
+    { InputBit::down,        13},
+    { InputBit::right,       12},
+
+    { InputBit::mod_x,       11},
+    { InputBit::mod_y,       10},
+
+    { InputBit::select,      20},
+    { InputBit::start,       21},
+    { InputBit::home,        19},
+
+    { InputBit::c_left,      22},
+    { InputBit::c_up,        7 },
+    { InputBit::c_down,      9 },
+    { InputBit::a,           8 },
+    { InputBit::c_right,     26},
+
+    { InputBit::b,           3 },
+    { InputBit::x,           2 },
+    { InputBit::z,           1 },
+    { InputBit::up,          0 },
+
+    { InputBit::r,           27},
+    { InputBit::y,           6 },
+    { InputBit::lightshield, 5 },
+    { InputBit::midshield,   4 },
 };
 size_t button_count = sizeof(button_mappings) / sizeof(GpioButtonMapping);
 
@@ -79,8 +86,12 @@ void setup() {
     gpio_set_dir(PICO_DEFAULT_LED_PIN, GPIO_OUT);
     gpio_put(PICO_DEFAULT_LED_PIN, 1);
 
+    // Create Nunchuk input source. It's read on the second core, and its readings are picked up
+    // along with the other inputs.
+    nunchuk = new NunchukInput(Wire, pinout.nunchuk_detect, pinout.nunchuk_sda, pinout.nunchuk_scl);
+
     // Create array of input sources to be used.
-    static InputSource *input_sources[] = { gpio_input };
+    static InputSource *input_sources[] = { gpio_input, nunchuk };
     size_t input_source_count = sizeof(input_sources) / sizeof(InputSource *);
 
     ConnectedConsole console = detect_console(pinout.joybus_data);
@@ -156,21 +167,22 @@ void loop() {
     }
 }
 
-/* Nunchuk code runs on the second core */
-NunchukInput *nunchuk = nullptr;
-
+/* Nunchuk reads, and report preparation if enabled, run on the second core */
 void setup1() {
     while (backends == nullptr) {
         tight_loop_contents();
     }
-
-    // Create Nunchuk input source.
-    nunchuk = new NunchukInput(Wire, pinout.nunchuk_detect, pinout.nunchuk_sda, pinout.nunchuk_scl);
 }
 
 void loop1() {
     if (backends != nullptr) {
-        nunchuk->UpdateInputs(backends[0]->GetInputs());
-        busy_wait_us(50);
+        nunchuk->Poll();
+#ifdef PREPARE_REPORTS_ON_CORE1
+        // Keep the next report up to date until the Nunchuk is read again.
+        const uint32_t nunchuk_due = timebase::now_us() + 50;
+        while (!nunchuk->Detected() && !timebase::reached(nunchuk_due)) {
+            backends[0]->PrepareNextReport();
+        }
+#endif
     }
 }
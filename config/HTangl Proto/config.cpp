@@ -19,33 +19,33 @@ size_t backend_count;
 KeyboardMode *current_kb_mode = nullptr;
 
 GpioButtonMapping button_mappings[] = {
-    {&InputState::l,            A5},
-    { &InputState::left,        A4},
-    { &InputState::down,        A3},
-    { &InputState::right,       15},
-
-    { &InputState::mod_x,       16},
-    { &InputState::mod_y,       14},
-
-    { &InputState::select,      0 },
-    { &InputState::start,       1 },
-    { &InputState::home,        2 },
-
-    { &InputState::c_left,      8 },
-    { &InputState::c_up,        11},
-    { &InputState::c_down,      7 },
-    { &InputState::a,           9 },
-    { &InputState::c_right,     10},
-
-    { &InputState::b,           A1},
-    { &InputState::x,           A2},
-    { &InputState::z,           3 },
-    { &InputState::up,          4 },
-
-    { &InputState::r,           6 },
-    { &InputState::y,           5 },
-    { &InputState::lightshield, 13},
-    { &InputState::midshield,   12},
+    {InputBit::l,            A5},
+    { InputBit::left,        A4},
+    { InputBit::down,        A3},
+    { InputBit::right,       15},
+
+    { InputBit::mod_x,       16},
+    { InputBit::mod_y,       14},
+
+    { InputBit::select,      0 },
+    { InputBit::start,       1 },
+    { InputBit::home,        2 },
+
+    { InputBit::c_left,      8 },
+    { InputBit::c_up,        11},
+    { InputBit::c_down,      7 },
+    { InputBit::a,           9 },
+    { InputBit::c_right,     10},
+
+    { InputBit::b,           A1},
+    { InputBit::x,           A2},
+    { InputBit::z,           3 },
+    { InputBit::up,          4 },
+
+    { InputBit::r,           6 },
+    { InputBit::y,           5 },
+    { InputBit::lightshield, 13},
+    { InputBit::midshield,   12},
 };
 size_t button_count = sizeof(button_mappings) / sizeof(GpioButtonMapping);
 
@@ -19,33 +19,33 @@ size_t backend_count;
 KeyboardMode *current_kb_mode = nullptr;
 
 GpioButtonMapping button_mappings[] = {
-    {&InputState::l,            6 },
-    { &InputState::left,        4 },
-    { &InputState::down,        0 },
-    { &InputState::right,       1 },
-
-    { &InputState::mod_x,       14},
-    { &InputState::mod_y,       16},
-
-    { &InputState::select,      2 },
-    { &InputState::start,       3 },
-    { &InputState::home,        5 },
-
-    { &InputState::c_left,      A2},
-    { &InputState::c_up,        A3},
-    { &InputState::c_down,      15},
-    { &InputState::a,           A5},
-    { &InputState::c_right,     A4},
-
-    { &InputState::b,           7 },
-    { &InputState::x,           9 },
-    { &InputState::z,           12},
-    { &InputState::up,          A0},
-
-    { &InputState::r,           10},
-    { &InputState::y,           11},
-    { &InputState::lightshield, 13},
-    { &InputState::midshield,   A1},
+    {InputBit::l,            6 },
+    { InputBit::left,        4 },
+    { InputBit::down,        0 },
+    { InputBit::right,       1 },
+
+    { InputBit::mod_x,       14},
+    { InputBit::mod_y,       16},
+
+    { InputBit::select,      2 },
+    { InputBit::start,       3 },
+    { InputBit::home,        5 },
+
+    { InputBit::c_left,      A2},
+    { InputBit::c_up,        A3},
+    { InputBit::c_down,      15},
+    { InputBit::a,           A5},
+    { InputBit::c_right,     A4},
+
+    { InputBit::b,           7 },
+    { InputBit::x,           9 },
+    { InputBit::z,           12},
+    { InputBit::up,          A0},
+
+    { InputBit::r,           10},
+    { InputBit::y,           11},
+    { InputBit::lightshield, 13},
+    { InputBit::midshield,   A1},
 };
 size_t button_count = sizeof(button_mappings) / sizeof(GpioButtonMapping);
 
@@ -21,64 +21,64 @@ KeyboardMode *current_kb_mode = nullptr;
 /*
 //rin~ swap the right hand rows, some other remaps
 #define ALTMAP \
-    {&InputState::l,            0},\
-    { &InputState::left,        7 },\
-    { &InputState::down,        11},\
-    { &InputState::right,       5 },\
+    {InputBit::l,            0},\
+    { InputBit::left,        7 },\
+    { InputBit::down,        11},\
+    { InputBit::right,       5 },\
 \
-    { &InputState::mod_x,       9 },\
-    { &InputState::mod_y,       A1},\
+    { InputBit::mod_x,       9 },\
+    { InputBit::mod_y,       A1},\
 \
-    { &InputState::select,      2 },\
-    { &InputState::start,       1 },\
-    { &InputState::home,        3 },\
+    { InputBit::select,      2 },\
+    { InputBit::start,       1 },\
+    { InputBit::home,        3 },\
 \
-    { &InputState::c_left,      A3},\
-    { &InputState::c_up,        A4},\
-    { &InputState::c_down,      A0},\
-    { &InputState::a,           10},\
-    { &InputState::c_right,     A2},\
+    { InputBit::c_left,      A3},\
+    { InputBit::c_up,        A4},\
+    { InputBit::c_down,      A0},\
+    { InputBit::a,           10},\
+    { InputBit::c_right,     A2},\
 \
-    { &InputState::b,           16 },\
-    { &InputState::x,           4 },\
-    { &InputState::z,           8 },\
-    { &InputState::up,          12 },\
+    { InputBit::b,           16 },\
+    { InputBit::x,           4 },\
+    { InputBit::z,           8 },\
+    { InputBit::up,          12 },\
 \
-    { &InputState::r,           6},\
-    { &InputState::y,           A5},\
-    { &InputState::lightshield, 14},\
-    { &InputState::midshield,   15},
+    { InputBit::r,           6},\
+    { InputBit::y,           A5},\
+    { InputBit::lightshield, 14},\
+    { InputBit::midshield,   15},
 */
 
 GpioButtonMapping button_mappings[] = {
 #ifndef ALTMAP
-    {&InputState::l,            12},
-    { &InputState::left,        7 },
-    { &InputState::down,        11},
-    { &InputState::right,       5 },
-
-    { &InputState::mod_x,       9 },
-    { &InputState::mod_y,       A1},
-
-    { &InputState::select,      2 },
-    { &InputState::start,       1 },
-    { &InputState::home,        3 },
-
-    { &InputState::c_left,      A3},
-    { &InputState::c_up,        A4},
-    { &InputState::c_down,      A0},
-    { &InputState::a,           10},
-    { &InputState::c_right,     A2},
-
-    { &InputState::b,           0 },
-    { &InputState::x,           4 },
-    { &InputState::z,           6 },
-    { &InputState::up,          8 },
-
-    { &InputState::r,           16},
-    { &InputState::y,           15},
-    { &InputState::lightshield, A5},
-    { &InputState::midshield,   14},
+    {InputBit::l,            12},
+    { InputBit::left,        7 },
+    { InputBit::down,        11},
+    { InputBit::right,       5 },
+
+    { InputBit::mod_x,       9 },
+    { InputBit::mod_y,       A1},
+
+    { InputBit::select,      2 },
+    { InputBit::start,       1 },
+    { InputBit::home,        3 },
+
+    { InputBit::c_left,      A3},
+    { InputBit::c_up,        A4},
+    { InputBit::c_down,      A0},
+    { InputBit::a,           10},
+    { InputBit::c_right,     A2},
+
+    { InputBit::b,           0 },
+    { InputBit::x,           4 },
+    { InputBit::z,           6 },
+    { InputBit::up,          8 },
+
+    { InputBit::r,           16},
+    { InputBit::y,           15},
+    { InputBit::lightshield, A5},
+    { InputBit::midshield,   14},
 #else
 ALTMAP
 #endif
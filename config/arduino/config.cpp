@@ -18,33 +18,33 @@ KeyboardMode *current_kb_mode = nullptr;
 
 // Customise this to match your controller's pinout.
 GpioButtonMapping button_mappings[] = {
-    {&InputState::l,            15},
-    { &InputState::left,        16},
-    { &InputState::down,        14},
-    { &InputState::right,       1 },
-
-    { &InputState::mod_x,       12},
-    { &InputState::mod_y,       0 },
-
-    { &InputState::select,      2 },
-    { &InputState::start,       4 },
-    { &InputState::home,        3 },
-
-    { &InputState::c_left,      8 },
-    { &InputState::c_up,        10},
-    { &InputState::c_down,      6 },
-    { &InputState::a,           9 },
-    { &InputState::c_right,     5 },
-
-    { &InputState::b,           A2},
-    { &InputState::x,           A1},
-    { &InputState::z,           A0},
-    { &InputState::up,          13},
-
-    { &InputState::r,           7 },
-    { &InputState::y,           A5},
-    { &InputState::lightshield, A4},
-    { &InputState::midshield,   A3},
+    {InputBit::l,            15},
+    { InputBit::left,        16},
+    { InputBit::down,        14},
+    { InputBit::right,       1 },
+
+    { InputBit::mod_x,       12},
+    { InputBit::mod_y,       0 },
+
+    { InputBit::select,      2 },
+    { InputBit::start,       4 },
+    { InputBit::home,        3 },
+
+    { InputBit::c_left,      8 },
+    { InputBit::c_up,        10},
+    { InputBit::c_down,      6 },
+    { InputBit::a,           9 },
+    { InputBit::c_right,     5 },
+
+    { InputBit::b,           A2},
+    { InputBit::x,           A1},
+    { InputBit::z,           A0},
+    { InputBit::up,          13},
+
+    { InputBit::r,           7 },
+    { InputBit::y,           A5},
+    { InputBit::lightshield, A4},
+    { InputBit::midshield,   A3},
 };
 size_t button_count = sizeof(button_mappings) / sizeof(GpioButtonMapping);
 
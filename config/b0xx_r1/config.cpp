@@ -21,29 +21,29 @@ size_t backend_count;
 KeyboardMode *current_kb_mode = nullptr;
 
 GpioButtonMapping button_mappings[] = {
-    {&InputState::l,        7 },
-    { &InputState::left,    15},
-    { &InputState::down,    16},
-    { &InputState::right,   14},
+    {InputBit::l,        7 },
+    { InputBit::left,    15},
+    { InputBit::down,    16},
+    { InputBit::right,   14},
 
-    { &InputState::mod_x,   8 },
-    { &InputState::mod_y,   6 },
+    { InputBit::mod_x,   8 },
+    { InputBit::mod_y,   6 },
 
-    { &InputState::start,   12},
+    { InputBit::start,   12},
 
-    { &InputState::c_left,  A1},
-    { &InputState::c_up,    A2},
-    { &InputState::c_down,  5 },
-    { &InputState::a,       13},
-    { &InputState::c_right, A0},
+    { InputBit::c_left,  A1},
+    { InputBit::c_up,    A2},
+    { InputBit::c_down,  5 },
+    { InputBit::a,       13},
+    { InputBit::c_right, A0},
 
-    { &InputState::b,       4 },
-    { &InputState::x,       A5},
-    { &InputState::z,       A4},
-    { &InputState::up,      A3},
+    { InputBit::b,       4 },
+    { InputBit::x,       A5},
+    { InputBit::z,       A4},
+    { InputBit::up,      A3},
 
-    { &InputState::r,       0 },
-    { &InputState::y,       1 },
+    { InputBit::r,       0 },
+    { InputBit::y,       1 },
 };
 size_t button_count = sizeof(button_mappings) / sizeof(GpioButtonMapping);
 
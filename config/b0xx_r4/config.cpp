@@ -16,39 +16,46 @@
 #include "joybus_utils.hpp"
 #include "modes/Melee20Button.hpp"
 #include "stdlib.hpp"
+#include "timebase.hpp"
 
 #include <pico/bootrom.h>
 
+// Uncomment to have the second core prepare GameCube reports continuously instead of sampling
+// inputs on a schedule ahead of each poll. It only does so while no Nunchuk is connected, as
+// reading one blocks the second core.
+//#define PREPARE_REPORTS_ON_CORE1
+
 CommunicationBackend **backends = nullptr;
 size_t backend_count;
+NunchukInput *nunchuk = nullptr;
 KeyboardMode *current_kb_mode = nullptr;
 
 GpioButtonMapping button_mappings[] = {
-    {&InputState::l,            6 },
-    { &InputState::left,        7 },
-    { &InputState::down,        8 },
-    { &InputState::right,       9 },
-
-    { &InputState::mod_x,       10},
-    { &InputState::mod_y,       11},
-
-    { &InputState::start,       12},
-
-    { &InputState::c_left,      14},
-    { &InputState::c_up,        13},
-    { &InputState::c_down,      27},
-    { &InputState::a,           28},
-    { &InputState::c_right,     15},
-
-    { &InputState::b,           19},
-    { &InputState::x,           18},
-    { &InputState::z,           17},
-    { &InputState::up,          16},
-
-    { &InputState::r,           26},
-    { &InputState::y,           22},
-    { &InputState::lightshield, 21},
-    { &InputState::midshield,   20},
+    {InputBit::l,            6 },
+    { InputBit::left,        7 },
+    { InputBit::down,        8 },
+    { InputBit::right,       9 },
+
+    { InputBit::mod_x,       10},
+    { InputBit::mod_y,       11},
+
+    { InputBit::start,       12},
+
+    { InputBit::c_left,      14},
+    { InputBit::c_up,        13},
+    { InputBit::c_down,      27},
+    { InputBit::a,           28},
+    { InputBit::c_right,     15},
+
+    { InputBit::b,           19},
+    { InputBit::x,           18},
+    { InputBit::z,           17},
+    { InputBit::up,          16},
+
+    { InputBit::r,           26},
+    { InputBit::y,           22},
+    { InputBit::lightshield, 21},
+    { InputBit::midshield,   20},
 };
 size_t button_count = sizeof(button_mappings) / sizeof(GpioButtonMapping);
 
@@ -81,8 +88,12 @@ void setup() {
     gpio_init(1);
     gpio_set_dir(1, GPIO_OUT);
 
+    // Create Nunchuk input source. It's read on the second core, and its readings are picked up
+    // along with the other inputs.
+    nunchuk = new NunchukInput(Wire, pinout.nunchuk_detect, pinout.nunchuk_sda, pinout.nunchuk_scl);
+
     // Create array of input sources to be used.
-    static InputSource *input_sources[] = { gpio_input };
+    static InputSource *input_sources[] = { gpio_input, nunchuk };
     size_t input_source_count = sizeof(input_sources) / sizeof(InputSource *);
 
     ConnectedConsole console = detect_console(pinout.joybus_data);
@@ -158,21 +169,22 @@ void loop() {
     }
 }
 
-/* Nunchuk code runs on the second core */
-NunchukInput *nunchuk = nullptr;
-
+/* Nunchuk reads, and report preparation if enabled, run on the second core */
 void setup1() {
     while (backends == nullptr) {
         tight_loop_contents();
     }
-
-    // Create Nunchuk input source.
-    nunchuk = new NunchukInput(Wire, pinout.nunchuk_detect, pinout.nunchuk_sda, pinout.nunchuk_scl);
 }
 
 void loop1() {
     if (backends != nullptr) {
-        nunchuk->UpdateInputs(backends[0]->GetInputs());
-        busy_wait_us(50);
+        nunchuk->Poll();
+#ifdef PREPARE_REPORTS_ON_CORE1
+        // Keep the next report up to date until the Nunchuk is read again.
+        const uint32_t nunchuk_due = timebase::now_us() + 50;
+        while (!nunchuk->Detected() && !timebase::reached(nunchuk_due)) {
+            backends[0]->PrepareNextReport();
+        }
+#endif
     }
 }
@@ -17,30 +17,30 @@ size_t backend_count;
 KeyboardMode *current_kb_mode = nullptr;
 
 GpioButtonMapping button_mappings[] = {
-    {&InputState::l,            16},
-    { &InputState::left,        1 },
-    { &InputState::down,        0 },
-    { &InputState::right,       4 },
-    { &InputState::mod_x,       5 },
-    { &InputState::mod_y,       6 },
-
-    { &InputState::start,       7 },
-
-    { &InputState::c_left,      9 },
-    { &InputState::c_up,        8 },
-    { &InputState::c_down,      12},
-    { &InputState::a,           15},
-    { &InputState::c_right,     14},
-
-    { &InputState::b,           A2},
-    { &InputState::x,           A1},
-    { &InputState::z,           A0},
-    { &InputState::up,          13},
-
-    { &InputState::r,           A4},
-    { &InputState::y,           A3},
-    { &InputState::lightshield, 11},
-    { &InputState::midshield,   10},
+    {InputBit::l,            16},
+    { InputBit::left,        1 },
+    { InputBit::down,        0 },
+    { InputBit::right,       4 },
+    { InputBit::mod_x,       5 },
+    { InputBit::mod_y,       6 },
+
+    { InputBit::start,       7 },
+
+    { InputBit::c_left,      9 },
+    { InputBit::c_up,        8 },
+    { InputBit::c_down,      12},
+    { InputBit::a,           15},
+    { InputBit::c_right,     14},
+
+    { InputBit::b,           A2},
+    { InputBit::x,           A1},
+    { InputBit::z,           A0},
+    { InputBit::up,          13},
+
+    { InputBit::r,           A4},
+    { InputBit::y,           A3},
+    { InputBit::lightshield, 11},
+    { InputBit::midshield,   10},
 };
 size_t button_count = sizeof(button_mappings) / sizeof(GpioButtonMapping);
 
@@ -17,33 +17,33 @@ size_t backend_count;
 KeyboardMode *current_kb_mode = nullptr;
 
 GpioButtonMapping button_mappings[] = {
-    {&InputState::l,            2 },
-    { &InputState::left,        10},
-    { &InputState::down,        13},
-    { &InputState::right,       5 },
-
-    { &InputState::mod_x,       7 },
-    { &InputState::mod_y,       3 },
-
-    { &InputState::select,      9 },
-    { &InputState::start,       6 },
-    { &InputState::home,        8 },
-
-    { &InputState::c_left,      A1},
-    { &InputState::c_up,        A3},
-    { &InputState::c_down,      A0},
-    { &InputState::a,           A2},
-    { &InputState::c_right,     A4},
-
-    { &InputState::b,           A5},
-    { &InputState::x,           14},
-    { &InputState::z,           16},
-    { &InputState::up,          15},
-
-    { &InputState::r,           12},
-    { &InputState::y,           4 },
-    { &InputState::lightshield, 1 },
-    { &InputState::midshield,   0 },
+    {InputBit::l,            2 },
+    { InputBit::left,        10},
+    { InputBit::down,        13},
+    { InputBit::right,       5 },
+
+    { InputBit::mod_x,       7 },
+    { InputBit::mod_y,       3 },
+
+    { InputBit::select,      9 },
+    { InputBit::start,       6 },
+    { InputBit::home,        8 },
+
+    { InputBit::c_left,      A1},
+    { InputBit::c_up,        A3},
+    { InputBit::c_down,      A0},
+    { InputBit::a,           A2},
+    { InputBit::c_right,     A4},
+
+    { InputBit::b,           A5},
+    { InputBit::x,           14},
+    { InputBit::z,           16},
+    { InputBit::up,          15},
+
+    { InputBit::r,           12},
+    { InputBit::y,           4 },
+    { InputBit::lightshield, 1 },
+    { InputBit::midshield,   0 },
 };
 size_t button_count = sizeof(button_mappings) / sizeof(GpioButtonMapping);
 
@@ -21,32 +21,32 @@ KeyboardMode *current_kb_mode = nullptr;
 bool brook_mode = false;
 
 GpioButtonMapping button_mappings[] = {
-    {&InputState::l,            11},
-    { &InputState::left,        15},
-    { &InputState::down,        16},
-    { &InputState::right,       14},
-
-    { &InputState::mod_x,       3 },
-    { &InputState::mod_y,       0 },
-    { &InputState::nunchuk_c,   2 }, // Dpad Toggle button
-
-    { &InputState::start,       A5},
-
-    { &InputState::c_left,      4 },
-    { &InputState::c_up,        8 },
-    { &InputState::c_down,      1 },
-    { &InputState::a,           12},
-    { &InputState::c_right,     6 },
-
-    { &InputState::b,           13},
-    { &InputState::x,           5 },
-    { &InputState::z,           10},
-    { &InputState::up,          9 },
-
-    { &InputState::r,           A0},
-    { &InputState::y,           A1},
-    { &InputState::lightshield, A2},
-    { &InputState::midshield,   A3},
+    {InputBit::l,            11},
+    { InputBit::left,        15},
+    { InputBit::down,        16},
+    { InputBit::right,       14},
+
+    { InputBit::mod_x,       3 },
+    { InputBit::mod_y,       0 },
+    { InputBit::nunchuk_c,   2 }, // Dpad Toggle button
+
+    { InputBit::start,       A5},
+
+    { InputBit::c_left,      4 },
+    { InputBit::c_up,        8 },
+    { InputBit::c_down,      1 },
+    { InputBit::a,           12},
+    { InputBit::c_right,     6 },
+
+    { InputBit::b,           13},
+    { InputBit::x,           5 },
+    { InputBit::z,           10},
+    { InputBit::up,          9 },
+
+    { InputBit::r,           A0},
+    { InputBit::y,           A1},
+    { InputBit::lightshield, A2},
+    { InputBit::midshield,   A3},
 };
 size_t button_count = sizeof(button_mappings) / sizeof(GpioButtonMapping);
 
@@ -54,17 +54,17 @@ GpioButtonMapping brook_button_mappings[] = {
   // These are the only buttons which aren't also bound on brook board directly.
   // And so the only buttons which can be bound to dpad_up and l3 on brook
   // WARNING: Bind as few of these as you need, since it increases latency
-    {&InputState::l,          11},
+    {InputBit::l,          11},
 
-    { &InputState::mod_x,     3 },
-    { &InputState::mod_y,     0 },
-    { &InputState::nunchuk_c, 2 },
+    { InputBit::mod_x,     3 },
+    { InputBit::mod_y,     0 },
+    { InputBit::nunchuk_c, 2 },
 
-    { &InputState::c_left,    4 },
-    { &InputState::c_up,      8 },
-    { &InputState::c_down,    1 },
-    { &InputState::a,         12},
-    { &InputState::c_right,   6 },
+    { InputBit::c_left,    4 },
+    { InputBit::c_up,      8 },
+    { InputBit::c_down,    1 },
+    { InputBit::a,         12},
+    { InputBit::c_right,   6 },
 };
 
 Pinout pinout = {
@@ -0,0 +1,114 @@
+#include "comms/DInputBackend.hpp"
+#include "comms/GamecubeBackend.hpp"
+#include "comms/N64Backend.hpp"
+#include "config/mode_selection.hpp"
+#include "core/CommunicationBackend.hpp"
+#include "core/InputMode.hpp"
+#include "core/KeyboardMode.hpp"
+#include "core/pinout.hpp"
+#include "core/socd.hpp"
+#include "core/state.hpp"
+#include "input/GpioButtonInput.hpp"
+#include "joybus_utils.hpp"
+#include "modes/Melee20Button.hpp"
+#include "stdlib.hpp"
+
+#include <pico/bootrom.h>
+
+/*
+ * Host build of the Pico firmware for profiling and benchmarking. Uses the Pico pinout against
+ * simulated GPIO and a simulated console, see HAL/native/include/simulation.hpp.
+ */
+
+CommunicationBackend **backends = nullptr;
+size_t backend_count;
+KeyboardMode *current_kb_mode = nullptr;
+
+GpioButtonMapping button_mappings[] = {
+    {InputBit::l,            5 },
+    { InputBit::left,        4 },
+    { InputBit::down,        3 },
+    { InputBit::right,       2 },
+
+    { InputBit::mod_x,       6 },
+    { InputBit::mod_y,       7 },
+
+    { InputBit::select,      10},
+    { InputBit::start,       0 },
+    { InputBit::home,        11},
+
+    { InputBit::c_left,      13},
+    { InputBit::c_up,        12},
+    { InputBit::c_down,      15},
+    { InputBit::a,           14},
+    { InputBit::c_right,     16},
+
+    { InputBit::b,           26},
+    { InputBit::x,           21},
+    { InputBit::z,           19},
+    { InputBit::up,          17},
+
+    { InputBit::r,           27},
+    { InputBit::y,           22},
+    { InputBit::lightshield, 20},
+    { InputBit::midshield,   18},
+};
+size_t button_count = sizeof(button_mappings) / sizeof(GpioButtonMapping);
+
+const Pinout pinout = {
+    .joybus_data = 28,
+    .mux = -1,
+    .nunchuk_detect = -1,
+    .nunchuk_sda = -1,
+    .nunchuk_scl = -1,
+};
+
+void setup() {
+    // Create GPIO input source and use it to read button states for checking button holds.
+    GpioButtonInput *gpio_input = new GpioButtonInput(button_mappings, button_count);
+
+    InputState button_holds;
+    gpio_input->UpdateInputs(button_holds);
+
+    // Bootsel button hold as early as possible for safety.
+    if (button_holds.start) {
+        reset_usb_boot(0, 0);
+    }
+
+    // Create array of input sources to be used.
+    static InputSource *input_sources[] = { gpio_input };
+    size_t input_source_count = sizeof(input_sources) / sizeof(InputSource *);
+
+    ConnectedConsole console = detect_console(pinout.joybus_data);
+
+    /* Select communication backend. */
+    CommunicationBackend *primary_backend;
+    if (console == ConnectedConsole::GAMECUBE) {
+        primary_backend =
+            new GamecubeBackend(input_sources, input_source_count, pinout.joybus_data, !button_holds.a);
+    } else if (console == ConnectedConsole::N64) {
+        primary_backend = new N64Backend(input_sources, input_source_count, pinout.joybus_data);
+    } else {
+        primary_backend = new DInputBackend(input_sources, input_source_count, !button_holds.a);
+    }
+
+    backend_count = 1;
+    backends = new CommunicationBackend *[backend_count] { primary_backend };
+
+    // Default to Melee mode.
+    primary_backend->SetGameMode(
+        new Melee20Button(socd::SOCD_2IP_NO_REAC, { .crouch_walk_os = button_holds.down, .teleport_coords = button_holds.b })
+    );
+}
+
+void loop() {
+    select_mode(backends[0]);
+
+    for (size_t i = 0; i < backend_count; i++) {
+        backends[i]->SendReport();
+    }
+
+    if (current_kb_mode != nullptr) {
+        current_kb_mode->SendReport(backends[0]->GetInputs());
+    }
+}
@@ -0,0 +1,126 @@
+#include "core/ControllerMode.hpp"
+#include "core/socd.hpp"
+#include "core/state.hpp"
+#include "modes/extra/DarkSouls.hpp"
+#include "modes/extra/HollowKnight.hpp"
+#include "modes/extra/MKWii.hpp"
+#include "modes/extra/MultiVersus.hpp"
+#include "modes/extra/RocketLeague.hpp"
+#include "modes/extra/SaltAndSanctuary.hpp"
+#include "modes/extra/ShovelKnight.hpp"
+#include "modes/extra/Ultimate2.hpp"
+#include "stdlib.hpp"
+
+#include <stdio.h>
+
+/*
+ * Host check of the extra modes that are described by a TableModeLayout. Each mode is run over the
+ * same pseudo-random button presses with every SOCD type, and its outputs are hashed. The expected
+ * hashes were recorded by running the hand-written implementations the modes had before they were
+ * ported to TableMode through this same check, so a mismatch means that a mode no longer behaves as
+ * it used to. Exits with status 1 if any mode doesn't match.
+ */
+
+typedef struct {
+    const char *name;
+    ControllerMode *(*create)(socd::SocdType socd_type);
+    uint32_t expected_hash;
+} ModeCheck;
+
+template <typename Mode> static ControllerMode *create(socd::SocdType socd_type) {
+    return new Mode(socd_type);
+}
+
+static const ModeCheck mode_checks[] = {
+    {"DarkSouls",         create<DarkSouls>,        0x415095c2},
+    { "HollowKnight",     create<HollowKnight>,     0xff6c375f},
+    { "MKWii",            create<MKWii>,            0xd2281126},
+    { "MultiVersus",      create<MultiVersus>,      0x5115bb50},
+    { "RocketLeague",     create<RocketLeague>,     0x44bb76c0},
+    { "SaltAndSanctuary", create<SaltAndSanctuary>, 0x2fcc676b},
+    { "ShovelKnight",     create<ShovelKnight>,     0x4d717a07},
+    { "Ultimate2",        create<Ultimate2>,        0x3239e80b},
+};
+
+static const socd::SocdType socd_types[] = {
+    socd::SOCD_NEUTRAL,       socd::SOCD_2IP,           socd::SOCD_2IP_NO_REAC,
+    socd::SOCD_DIR1_PRIORITY, socd::SOCD_DIR2_PRIORITY, socd::SOCD_NONE,
+};
+
+// Button presses per mode and SOCD type.
+#define STEPS 50000
+
+static uint32_t xorshift32(uint32_t &state) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+static uint32_t fnv1a(uint32_t hash, uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+        hash = (hash ^ (value & 0xFF)) * 16777619;
+        value >>= 8;
+    }
+    return hash;
+}
+
+static uint32_t hash_mode(const ModeCheck &check) {
+    uint32_t hash = 2166136261;
+    for (socd::SocdType socd_type : socd_types) {
+        ControllerMode *mode = check.create(socd_type);
+        uint32_t random = 1;
+        InputState held;
+        for (uint32_t step = 0; step < STEPS; step++) {
+            // Press or release one button at a time, so that SOCD resolution sees the order in
+            // which directions were pressed. Now and then, plug or unplug a Nunchuk instead.
+            uint32_t roll = xorshift32(random);
+            if (roll % 64 == 0) {
+                held.nunchuk_connected = !held.nunchuk_connected;
+            } else {
+                held.buttons ^= input_mask((InputBit)(roll % (uint8_t)InputBit::nunchuk_connected));
+            }
+            if (held.nunchuk_connected) {
+                roll = xorshift32(random);
+                held.nunchuk_x = roll;
+                held.nunchuk_y = roll >> 8;
+                held.nunchuk_c = roll & (1 << 16);
+                held.nunchuk_z = roll & (1 << 17);
+            } else {
+                held.nunchuk_c = false;
+                held.nunchuk_z = false;
+            }
+
+            // Modes resolve SOCD in place, so they get a copy of the buttons held, and fresh
+            // outputs as a backend would give them.
+            InputState inputs = held;
+            OutputState outputs;
+            mode->UpdateOutputs(inputs, outputs);
+
+            hash = fnv1a(hash, outputs.digital);
+            hash = fnv1a(
+                hash,
+                outputs.leftStickX | outputs.leftStickY << 8 | outputs.rightStickX << 16 |
+                    outputs.rightStickY << 24
+            );
+            hash = fnv1a(hash, outputs.triggerLAnalog | outputs.triggerRAnalog << 8);
+        }
+        delete mode;
+    }
+    return hash;
+}
+
+void setup() {
+    int failures = 0;
+    for (const ModeCheck &check : mode_checks) {
+        uint32_t hash = hash_mode(check);
+        bool ok = hash == check.expected_hash;
+        printf("%-16s 0x%08x %s\n", check.name, hash, ok ? "ok" : "MISMATCH");
+        if (!ok) {
+            failures++;
+        }
+    }
+    exit(failures > 0 ? 1 : 0);
+}
+
+void loop() {}
@@ -11,205 +11,220 @@
 #include "core/pinout.hpp"
 #include "core/socd.hpp"
 #include "core/state.hpp"
+#include "input/ContinuousScanInput.hpp"
 #include "input/GpioButtonInput.hpp"
 #include "input/NunchukInput.hpp"
 #include "joybus_utils.hpp"
 #include "modes/Melee20Button.hpp"
 #include "stdlib.hpp"
+#include "timebase.hpp"
 
 #include <pico/bootrom.h>
 
+// Uncomment to have the second core prepare GameCube reports continuously instead of sampling
+// inputs on a schedule ahead of each poll. It only does so while no Nunchuk is connected, as
+// reading one blocks the second core.
+//#define PREPARE_REPORTS_ON_CORE1
+// Uncomment to have the second core scan the buttons continuously and timestamp every change, so
+// that reading them at each sample costs no scan. It only does so while no Nunchuk is connected,
+// for the same reason. Otherwise the buttons are scanned directly.
+//#define SCAN_BUTTONS_ON_CORE1
+
 CommunicationBackend **backends = nullptr;
 size_t backend_count;
+NunchukInput *nunchuk = nullptr;
+#ifdef SCAN_BUTTONS_ON_CORE1
+ContinuousScanInput *buttons = nullptr;
+#endif
 KeyboardMode *current_kb_mode = nullptr;
 /*
 #define ALTMAP \
-    {&InputState::l,            5 },\
-    { &InputState::left,        4 },\
-    { &InputState::down,        3 },\
-    { &InputState::right,       2 },\
+    {InputBit::l,            5 },\
+    { InputBit::left,        4 },\
+    { InputBit::down,        3 },\
+    { InputBit::right,       2 },\
 \
-    { &InputState::mod_x,       6 },\
-    { &InputState::mod_y,       7 },\
+    { InputBit::mod_x,       6 },\
+    { InputBit::mod_y,       7 },\
 \
-    { &InputState::select,      10},\
-    { &InputState::start,       0 },\
-    { &InputState::home,        11},\
+    { InputBit::select,      10},\
+    { InputBit::start,       0 },\
+    { InputBit::home,        11},\
 \
-    { &InputState::c_left,      13},\
-    { &InputState::c_up,        12},\
-    { &InputState::c_down,      15},\
-    { &InputState::a,           14},\
-    { &InputState::c_right,     16},\
+    { InputBit::c_left,      13},\
+    { InputBit::c_up,        12},\
+    { InputBit::c_down,      15},\
+    { InputBit::a,           14},\
+    { InputBit::c_right,     16},\
 \
-    { &InputState::b,           26},\
-    { &InputState::x,           21},\
-    { &InputState::z,           19},\
-    { &InputState::up,          17},\
+    { InputBit::b,           26},\
+    { InputBit::x,           21},\
+    { InputBit::z,           19},\
+    { InputBit::up,          17},\
 \
-    { &InputState::r,           27},\
-    { &InputState::y,           22},\
-    { &InputState::lightshield, 20},\
-    { &InputState::midshield,   18},
+    { InputBit::r,           27},\
+    { InputBit::y,           22},\
+    { InputBit::lightshield, 20},\
+    { InputBit::midshield,   18},
 */
 
 /*
 //Home row swap
 #define ALTMAP \
-    {&InputState::l,            5 },\
-    { &InputState::left,        4 },\
-    { &InputState::down,        3 },\
-    { &InputState::right,       2 },\
+    {InputBit::l,            5 },\
+    { InputBit::left,        4 },\
+    { InputBit::down,        3 },\
+    { InputBit::right,       2 },\
 \
-    { &InputState::mod_x,       6 },\
-    { &InputState::mod_y,       7 },\
+    { InputBit::mod_x,       6 },\
+    { InputBit::mod_y,       7 },\
 \
-    { &InputState::select,      10},\
-    { &InputState::start,       0 },\
-    { &InputState::home,        11},\
+    { InputBit::select,      10},\
+    { InputBit::start,       0 },\
+    { InputBit::home,        11},\
 \
-    { &InputState::c_left,      13},\
-    { &InputState::c_up,        12},\
-    { &InputState::c_down,      15},\
-    { &InputState::a,           14},\
-    { &InputState::c_right,     16},\
+    { InputBit::c_left,      13},\
+    { InputBit::c_up,        12},\
+    { InputBit::c_down,      15},\
+    { InputBit::a,           14},\
+    { InputBit::c_right,     16},\
 \
-    { &InputState::b,           27},\
-    { &InputState::x,           22},\
-    { &InputState::z,           20},\
-    { &InputState::up,          18},\
+    { InputBit::b,           27},\
+    { InputBit::x,           22},\
+    { InputBit::z,           20},\
+    { InputBit::up,          18},\
 \
-    { &InputState::r,           26},\
-    { &InputState::y,           21},\
-    { &InputState::lightshield, 19},\
-    { &InputState::midshield,   18},
+    { InputBit::r,           26},\
+    { InputBit::y,           21},\
+    { InputBit::lightshield, 19},\
+    { InputBit::midshield,   18},
 */
 
 /*
 //Group A Chef: r/b swap
 #define ALTMAP \
-    {&InputState::l,            5 },\
-    { &InputState::left,        4 },\
-    { &InputState::down,        3 },\
-    { &InputState::right,       2 },\
+    {InputBit::l,            5 },\
+    { InputBit::left,        4 },\
+    { InputBit::down,        3 },\
+    { InputBit::right,       2 },\
 \
-    { &InputState::mod_x,       6 },\
-    { &InputState::mod_y,       7 },\
+    { InputBit::mod_x,       6 },\
+    { InputBit::mod_y,       7 },\
 \
-    { &InputState::select,      10},\
-    { &InputState::start,       0 },\
-    { &InputState::home,        11},\
+    { InputBit::select,      10},\
+    { InputBit::start,       0 },\
+    { InputBit::home,        11},\
 \
-    { &InputState::c_left,      13},\
-    { &InputState::c_up,        12},\
-    { &InputState::c_down,      15},\
-    { &InputState::a,           14},\
-    { &InputState::c_right,     16},\
+    { InputBit::c_left,      13},\
+    { InputBit::c_up,        12},\
+    { InputBit::c_down,      15},\
+    { InputBit::a,           14},\
+    { InputBit::c_right,     16},\
 \
-    { &InputState::b,           27},\
-    { &InputState::x,           21},\
-    { &InputState::z,           19},\
-    { &InputState::up,          17},\
+    { InputBit::b,           27},\
+    { InputBit::x,           21},\
+    { InputBit::z,           19},\
+    { InputBit::up,          17},\
 \
-    { &InputState::r,           26},\
-    { &InputState::y,           22},\
-    { &InputState::lightshield, 20},\
-    { &InputState::midshield,   18},
+    { InputBit::r,           26},\
+    { InputBit::y,           22},\
+    { InputBit::lightshield, 20},\
+    { InputBit::midshield,   18},
 */
 
 /*
 //Group A Daniel
 #define ALTMAP \
-    {&InputState::l,            19},\
-    { &InputState::left,        4 },\
-    { &InputState::down,        3 },\
-    { &InputState::right,       2 },\
+    {InputBit::l,            19},\
+    { InputBit::left,        4 },\
+    { InputBit::down,        3 },\
+    { InputBit::right,       2 },\
 \
-    { &InputState::mod_x,       6 },\
-    { &InputState::mod_y,       7 },\
+    { InputBit::mod_x,       6 },\
+    { InputBit::mod_y,       7 },\
 \
-    { &InputState::select,      10},\
-    { &InputState::start,       0 },\
-    { &InputState::home,        9},\
+    { InputBit::select,      10},\
+    { InputBit::start,       0 },\
+    { InputBit::home,        9},\
 \
-    { &InputState::c_left,      13},\
-    { &InputState::c_up,        12},\
-    { &InputState::c_down,      20},\
-    { &InputState::a,           14},\
-    { &InputState::c_right,     16},\
+    { InputBit::c_left,      13},\
+    { InputBit::c_up,        12},\
+    { InputBit::c_down,      20},\
+    { InputBit::a,           14},\
+    { InputBit::c_right,     16},\
 \
-    { &InputState::b,           15},\
-    { &InputState::x,           21},\
-    { &InputState::z,           17},\
-    { &InputState::up,          26},\
+    { InputBit::b,           15},\
+    { InputBit::x,           21},\
+    { InputBit::z,           17},\
+    { InputBit::up,          26},\
 \
-    { &InputState::r,           27},\
-    { &InputState::y,           22},\
-    { &InputState::lightshield, 5 },\
-    { &InputState::midshield,   18},
+    { InputBit::r,           27},\
+    { InputBit::y,           22},\
+    { InputBit::lightshield, 5 },\
+    { InputBit::midshield,   18},
 */
 
 /*
 //Group C Potion: B/Z and cu/cd swap for peach
 #define ALTMAP \
-    {&InputState::l,            5 },\
-    { &InputState::left,        4 },\
-    { &InputState::down,        3 },\
-    { &InputState::right,       2 },\
+    {InputBit::l,            5 },\
+    { InputBit::left,        4 },\
+    { InputBit::down,        3 },\
+    { InputBit::right,       2 },\
 \
-    { &InputState::mod_x,       6 },\
-    { &InputState::mod_y,       7 },\
+    { InputBit::mod_x,       6 },\
+    { InputBit::mod_y,       7 },\
 \
-    { &InputState::select,      10},\
-    { &InputState::start,       0 },\
-    { &InputState::home,        11},\
+    { InputBit::select,      10},\
+    { InputBit::start,       0 },\
+    { InputBit::home,        11},\
 \
-    { &InputState::c_left,      13},\
-    { &InputState::c_up,        15},\
-    { &InputState::c_down,      12},\
-    { &InputState::a,           14},\
-    { &InputState::c_right,     16},\
+    { InputBit::c_left,      13},\
+    { InputBit::c_up,        15},\
+    { InputBit::c_down,      12},\
+    { InputBit::a,           14},\
+    { InputBit::c_right,     16},\
 \
-    { &InputState::b,           19},\
-    { &InputState::x,           21},\
-    { &InputState::z,           26},\
-    { &InputState::up,          17},\
+    { InputBit::b,           19},\
+    { InputBit::x,           21},\
+    { InputBit::z,           26},\
+    { InputBit::up,          17},\
 \
-    { &InputState::r,           27},\
-    { &InputState::y,           22},\
-    { &InputState::lightshield, 20},\
-    { &InputState::midshield,   18},
+    { InputBit::r,           27},\
+    { InputBit::y,           22},\
+    { InputBit::lightshield, 20},\
+    { InputBit::midshield,   18},
 */
 
 GpioButtonMapping button_mappings[] = {
 #ifndef ALTMAP
-    {&InputState::l,            5 },
-    { &InputState::left,        4 },
-    { &InputState::down,        3 },
-    { &InputState::right,       2 },
-
-    { &InputState::mod_x,       6 },
-    { &InputState::mod_y,       7 },
-
-    { &InputState::select,      10},
-    { &InputState::start,       0 },
-    { &InputState::home,        11},
-
-    { &InputState::c_left,      13},
-    { &InputState::c_up,        12},
-    { &InputState::c_down,      15},
-    { &InputState::a,           14},
-    { &InputState::c_right,     16},
-
-    { &InputState::b,           26},
-    { &InputState::x,           21},
-    { &InputState::z,           19},
-    { &InputState::up,          17},
-
-    { &InputState::r,           27},
-    { &InputState::y,           22},
-    { &InputState::lightshield, 20},
-    { &InputState::midshield,   18},
+    {InputBit::l,            5 },
+    { InputBit::left,        4 },
+    { InputBit::down,        3 },
+    { InputBit::right,       2 },
+
+    { InputBit::mod_x,       6 },
+    { InputBit::mod_y,       7 },
+
+    { InputBit::select,      10},
+    { InputBit::start,       0 },
+    { InputBit::home,        11},
+
+    { InputBit::c_left,      13},
+    { InputBit::c_up,        12},
+    { InputBit::c_down,      15},
+    { InputBit::a,           14},
+    { InputBit::c_right,     16},
+
+    { InputBit::b,           26},
+    { InputBit::x,           21},
+    { InputBit::z,           19},
+    { InputBit::up,          17},
+
+    { InputBit::r,           27},
+    { InputBit::y,           22},
+    { InputBit::lightshield, 20},
+    { InputBit::midshield,   18},
 #else
 ALTMAP
 #endif
@@ -245,8 +260,18 @@ void setup() {
     gpio_init(1);
     gpio_set_dir(1, GPIO_OUT);
 
+    // Create Nunchuk input source. It's read on the second core, and its readings are picked up
+    // along with the other inputs.
+    nunchuk = new NunchukInput(Wire, pinout.nunchuk_detect, pinout.nunchuk_sda, pinout.nunchuk_scl);
+
     // Create array of input sources to be used.
-    static InputSource *input_sources[] = { gpio_input };
+#ifdef SCAN_BUTTONS_ON_CORE1
+    // The buttons are scanned here until the second core takes over.
+    buttons = new ContinuousScanInput(gpio_input);
+    static InputSource *input_sources[] = { buttons, nunchuk };
+#else
+    static InputSource *input_sources[] = { gpio_input, nunchuk };
+#endif
     size_t input_source_count = sizeof(input_sources) / sizeof(InputSource *);
 
     ConnectedConsole console = detect_console(pinout.joybus_data);
@@ -322,21 +347,28 @@ void loop() {
     }
 }
 
-/* Nunchuk code runs on the second core */
-NunchukInput *nunchuk = nullptr;
-
+/* Nunchuk reads, and button scans and report preparation if enabled, run on the second core */
 void setup1() {
     while (backends == nullptr) {
         tight_loop_contents();
     }
-
-    // Create Nunchuk input source.
-    nunchuk = new NunchukInput(Wire, pinout.nunchuk_detect, pinout.nunchuk_sda, pinout.nunchuk_scl);
 }
 
 void loop1() {
     if (backends != nullptr) {
-        nunchuk->UpdateInputs(backends[0]->GetInputs());
-        busy_wait_us(50);
+        nunchuk->Poll();
+#if defined(SCAN_BUTTONS_ON_CORE1) || defined(PREPARE_REPORTS_ON_CORE1)
+        // Keep scanning the buttons and the next report up to date, as enabled, until the Nunchuk
+        // is read again.
+        const uint32_t nunchuk_due = timebase::now_us() + 50;
+        while (!nunchuk->Detected() && !timebase::reached(nunchuk_due)) {
+#ifdef SCAN_BUTTONS_ON_CORE1
+            buttons->Scan();
+#endif
+#ifdef PREPARE_REPORTS_ON_CORE1
+            backends[0]->PrepareNextReport();
+#endif
+        }
+#endif
     }
 }
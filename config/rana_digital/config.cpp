@@ -16,109 +16,116 @@
 #include "joybus_utils.hpp"
 #include "modes/Melee20Button.hpp"
 #include "stdlib.hpp"
+#include "timebase.hpp"
 
 #include <pico/bootrom.h>
 
+// Uncomment to have the second core prepare GameCube reports continuously instead of sampling
+// inputs on a schedule ahead of each poll. It only does so while no Nunchuk is connected, as
+// reading one blocks the second core.
+//#define PREPARE_REPORTS_ON_CORE1
+
 CommunicationBackend **backends = nullptr;
 size_t backend_count;
+NunchukInput *nunchuk = nullptr;
 KeyboardMode *current_kb_mode = nullptr;
 
 /*
 //verbose: X Up B Z on home row
 #define ALTMAP \
-    {&InputState::l,            5 },\
-    { &InputState::left,        4 },\
-    { &InputState::down,        3 },\
-    { &InputState::right,       2 },\
-    { &InputState::nunchuk_c,   1 },\
+    {InputBit::l,            5 },\
+    { InputBit::left,        4 },\
+    { InputBit::down,        3 },\
+    { InputBit::right,       2 },\
+    { InputBit::nunchuk_c,   1 },\
 \
-    { &InputState::mod_x,       6 },\
-    { &InputState::mod_y,       7 },\
+    { InputBit::mod_x,       6 },\
+    { InputBit::mod_y,       7 },\
 \
-    { &InputState::select,      10},\
-    { &InputState::start,       0 },\
-    { &InputState::home,        11},\
+    { InputBit::select,      10},\
+    { InputBit::start,       0 },\
+    { InputBit::home,        11},\
 \
-    { &InputState::c_left,      13},\
-    { &InputState::c_up,        12},\
-    { &InputState::c_down,      15},\
-    { &InputState::a,           14},\
-    { &InputState::c_right,     16},\
+    { InputBit::c_left,      13},\
+    { InputBit::c_up,        12},\
+    { InputBit::c_down,      15},\
+    { InputBit::a,           14},\
+    { InputBit::c_right,     16},\
 \
-    { &InputState::x,           26},\
-    { &InputState::up,           21},\
-    { &InputState::b,           19},\
-    { &InputState::z,          17},\
+    { InputBit::x,           26},\
+    { InputBit::up,           21},\
+    { InputBit::b,           19},\
+    { InputBit::z,          17},\
 \
-    { &InputState::r,           27},\
-    { &InputState::y,           22},\
-    { &InputState::lightshield, 20},\
-    { &InputState::midshield,   18},\
+    { InputBit::r,           27},\
+    { InputBit::y,           22},\
+    { InputBit::lightshield, 20},\
+    { InputBit::midshield,   18},\
 */
 
 /*
 //Group C technospider
 #define ALTMAP \
-    {&InputState::l,            18},\
-    { &InputState::left,        4 },\
-    { &InputState::down,        3 },\
-    { &InputState::right,       2 },\
-    { &InputState::nunchuk_c,   7 },\
+    {InputBit::l,            18},\
+    { InputBit::left,        4 },\
+    { InputBit::down,        3 },\
+    { InputBit::right,       2 },\
+    { InputBit::nunchuk_c,   7 },\
 \
-    { &InputState::mod_x,       6 },\
-    { &InputState::mod_y,       17},\
+    { InputBit::mod_x,       6 },\
+    { InputBit::mod_y,       17},\
 \
-    { &InputState::select,      10},\
-    { &InputState::start,       0 },\
-    { &InputState::home,        11},\
+    { InputBit::select,      10},\
+    { InputBit::start,       0 },\
+    { InputBit::home,        11},\
 \
-    { &InputState::c_left,      13},\
-    { &InputState::c_up,        12},\
-    { &InputState::c_down,      15},\
-    { &InputState::a,           14},\
-    { &InputState::c_right,     16},\
+    { InputBit::c_left,      13},\
+    { InputBit::c_up,        12},\
+    { InputBit::c_down,      15},\
+    { InputBit::a,           14},\
+    { InputBit::c_right,     16},\
 \
-    { &InputState::b,           21},\
-    { &InputState::x,           19},\
-    { &InputState::z,           22},\
-    { &InputState::up,          1 },\
+    { InputBit::b,           21},\
+    { InputBit::x,           19},\
+    { InputBit::z,           22},\
+    { InputBit::up,          1 },\
 \
-    { &InputState::r,           27},\
-    { &InputState::y,           20},\
-    { &InputState::lightshield, 5 },\
-    { &InputState::midshield,   26},\
+    { InputBit::r,           27},\
+    { InputBit::y,           20},\
+    { InputBit::lightshield, 5 },\
+    { InputBit::midshield,   26},\
 */
 
 GpioButtonMapping button_mappings[] = {
 #ifndef ALTMAP
-    {&InputState::l,            5 },
-    { &InputState::left,        4 },
-    { &InputState::down,        3 },
-    { &InputState::right,       2 },
-    { &InputState::nunchuk_c,   1 },
-
-    { &InputState::mod_x,       6 },
-    { &InputState::mod_y,       7 },
-
-    { &InputState::select,      10},
-    { &InputState::start,       0 },
-    { &InputState::home,        11},
-
-    { &InputState::c_left,      13},
-    { &InputState::c_up,        12},
-    { &InputState::c_down,      15},
-    { &InputState::a,           14},
-    { &InputState::c_right,     16},
-
-    { &InputState::b,           26},
-    { &InputState::x,           21},
-    { &InputState::z,           19},
-    { &InputState::up,          17},
-
-    { &InputState::r,           27},
-    { &InputState::y,           22},
-    { &InputState::lightshield, 20},
-    { &InputState::midshield,   18},
+    {InputBit::l,            5 },
+    { InputBit::left,        4 },
+    { InputBit::down,        3 },
+    { InputBit::right,       2 },
+    { InputBit::nunchuk_c,   1 },
+
+    { InputBit::mod_x,       6 },
+    { InputBit::mod_y,       7 },
+
+    { InputBit::select,      10},
+    { InputBit::start,       0 },
+    { InputBit::home,        11},
+
+    { InputBit::c_left,      13},
+    { InputBit::c_up,        12},
+    { InputBit::c_down,      15},
+    { InputBit::a,           14},
+    { InputBit::c_right,     16},
+
+    { InputBit::b,           26},
+    { InputBit::x,           21},
+    { InputBit::z,           19},
+    { InputBit::up,          17},
+
+    { InputBit::r,           27},
+    { InputBit::y,           22},
+    { InputBit::lightshield, 20},
+    { InputBit::midshield,   18},
 #else
 ALTMAP
 #endif
@@ -155,8 +162,12 @@ void setup() {
     //gpio_init(1);
     //gpio_set_dir(1, GPIO_OUT);
 
+    // Create Nunchuk input source. It's read on the second core, and its readings are picked up
+    // along with the other inputs.
+    nunchuk = new NunchukInput(Wire, pinout.nunchuk_detect, pinout.nunchuk_sda, pinout.nunchuk_scl);
+
     // Create array of input sources to be used.
-    static InputSource *input_sources[] = { gpio_input };
+    static InputSource *input_sources[] = { gpio_input, nunchuk };
     size_t input_source_count = sizeof(input_sources) / sizeof(InputSource *);
 
     ConnectedConsole console = detect_console(pinout.joybus_data);
@@ -232,21 +243,22 @@ void loop() {
     }
 }
 
-/* Nunchuk code runs on the second core */
-NunchukInput *nunchuk = nullptr;
-
+/* Nunchuk reads, and report preparation if enabled, run on the second core */
 void setup1() {
     while (backends == nullptr) {
         tight_loop_contents();
     }
-
-    // Create Nunchuk input source.
-    nunchuk = new NunchukInput(Wire, pinout.nunchuk_detect, pinout.nunchuk_sda, pinout.nunchuk_scl);
 }
 
 void loop1() {
     if (backends != nullptr) {
-        nunchuk->UpdateInputs(backends[0]->GetInputs());
-        busy_wait_us(50);
+        nunchuk->Poll();
+#ifdef PREPARE_REPORTS_ON_CORE1
+        // Keep the next report up to date until the Nunchuk is read again.
+        const uint32_t nunchuk_due = timebase::now_us() + 50;
+        while (!nunchuk->Detected() && !timebase::reached(nunchuk_due)) {
+            backends[0]->PrepareNextReport();
+        }
+#endif
     }
 }
@@ -17,34 +17,34 @@ size_t backend_count;
 KeyboardMode *current_kb_mode = nullptr;
 
 GpioButtonMapping button_mappings[] = {
-    {&InputState::l,            47},
-    { &InputState::left,        24},
-    { &InputState::down,        23},
-    { &InputState::right,       25},
+    {InputBit::l,            47},
+    { InputBit::left,        24},
+    { InputBit::down,        23},
+    { InputBit::right,       25},
     //up is 22
 
-    { &InputState::mod_x,       28},
-    { &InputState::mod_y,       29},
-    { &InputState::select,      30},
-    { &InputState::home,        31},
+    { InputBit::mod_x,       28},
+    { InputBit::mod_y,       29},
+    { InputBit::select,      30},
+    { InputBit::home,        31},
 
-    { &InputState::start,       50},
+    { InputBit::start,       50},
 
-    { &InputState::c_left,      36},
-    { &InputState::c_up,        34},
-    { &InputState::c_down,      46},
-    { &InputState::a,           35},
-    { &InputState::c_right,     37},
+    { InputBit::c_left,      36},
+    { InputBit::c_up,        34},
+    { InputBit::c_down,      46},
+    { InputBit::a,           35},
+    { InputBit::c_right,     37},
 
-    { &InputState::b,           44},
-    { &InputState::x,           42},
-    { &InputState::z,           7 },
-    { &InputState::up,          45},
+    { InputBit::b,           44},
+    { InputBit::x,           42},
+    { InputBit::z,           7 },
+    { InputBit::up,          45},
 
-    { &InputState::r,           41},
-    { &InputState::y,           43},
-    { &InputState::lightshield, 40},
-    { &InputState::midshield,   12},
+    { InputBit::r,           41},
+    { InputBit::y,           43},
+    { InputBit::lightshield, 40},
+    { InputBit::midshield,   12},
 };
 size_t button_count = sizeof(button_mappings) / sizeof(GpioButtonMapping);
 
@@ -10,7 +10,7 @@ class CommunicationBackend {
     CommunicationBackend(InputSource **input_sources, size_t input_source_count);
     virtual ~CommunicationBackend(){};
 
-    InputState &GetInputs();
+    virtual InputState &GetInputs();
     void ScanInputs();
     void ScanInputs(InputScanSpeed input_source_filter);
 
@@ -18,6 +18,9 @@ class CommunicationBackend {
     virtual void SetGameMode(ControllerMode *gamemode);
 
     virtual void SendReport() = 0;
+    // Called in a loop from the second core by configs that opt in, so that backends can get the
+    // next report ready ahead of the poll. Does nothing by default.
+    virtual void PrepareNextReport(){};
 
   protected:
     InputState _inputs;
@@ -10,13 +10,18 @@ class InputMode {
     virtual ~InputMode();
 
   protected:
-    socd::SocdPair *_socd_pairs = nullptr;
-    size_t _socd_pair_count = 0;
+    // Sets the SOCD pairs to resolve, in order. Pairs are compiled up front so that resolving them
+    // on each poll needs no allocation or setup.
+    void SetSocdPairs(const socd::SocdPair *pairs, size_t pair_count);
+    template <size_t N> void SetSocdPairs(const socd::SocdPair (&pairs)[N]) {
+        SetSocdPairs(pairs, N);
+    }
 
     virtual void HandleSocd(InputState &inputs);
 
   private:
-    socd::SocdState *_socd_states = nullptr;
+    socd::SocdGroup *_socd_groups = nullptr;
+    size_t _socd_group_count = 0;
 };
 
 #endif
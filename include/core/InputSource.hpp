@@ -15,6 +15,8 @@ class InputSource {
     virtual ~InputSource(){};
     virtual InputScanSpeed ScanSpeed() = 0;
     virtual void UpdateInputs(InputState &inputs) = 0;
+    // The bits of InputState::buttons that UpdateInputs() sets, leaving the rest alone.
+    virtual uint32_t ButtonMask() { return 0; };
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,146 @@
+#ifndef _CORE_SAMPLESCHEDULER_HPP
+#define _CORE_SAMPLESCHEDULER_HPP
+
+#include "stdlib.hpp"
+
+/*
+ * Works out when to sample inputs between polls. It continuously tracks the period and phase of
+ * the poll loop from the start time of each loop, like a phase-locked loop. Once locked on, each
+ * poll interval is split into evenly spaced samples, a millisecond apart unless set otherwise.
+ * Each sample's deadline is a computation time budget ahead of the end of its slot, and the last
+ * slot ends where the next poll is predicted to start, so that the last report is ready just in
+ * time.
+ *
+ * A loop starts some time after its poll started, once the poll has been answered. That poll lead
+ * is either fixed, or measured from the poll start times the caller reports. A caller that knows
+ * exactly when each poll started can pass that as the loop start instead, for a lead of zero.
+ *
+ * Missed polls and the odd late one are tolerated without losing lock. If polls stop lining up
+ * with the prediction, the scheduler starts over, which takes a handful of polls.
+ *
+ * The budget calibrates itself from the durations the caller reports for each sample: after a
+ * short measuring period, it is the longest recent duration plus a safety margin. Until then, and
+ * whenever it is reset (e.g. because the mode changed), a conservative default is used. A fixed
+ * sample offset can be set instead.
+ *
+ * If a sample could no longer be ready before the poll, the caller should skip it and answer the
+ * poll with the previous report. Late and missed polls are counted, and each late one raises the
+ * budget a little.
+ *
+ * The scheduler only sees the timestamps it is given, so it can be driven from any clock.
+ */
+class SampleScheduler {
+  public:
+    // fastest_sample_us: shortest sample spacing that the platform can keep up with.
+    // computation_time_us: default budget for the time from the start of a sample until its report
+    //     is ready, used until the budget is calibrated.
+    // poll_lead_us: default time from the start of a poll until the next loop starts, used until
+    //     it is measured.
+    // max_sample_count: upper limit on samples per poll, or 0 for no limit.
+    SampleScheduler(
+        uint32_t fastest_sample_us,
+        uint32_t computation_time_us,
+        uint32_t poll_lead_us,
+        uint max_sample_count = 0
+    );
+
+    // Marks the start of a new poll loop. Must be called at the same point of every loop.
+    void StartLoop(uint32_t now_us);
+
+    // Whether the scheduler has yet to lock on to the poll timing. While it hasn't, the caller
+    // should sample once per loop without waiting.
+    bool Detecting();
+    // Estimated time between polls, or 0 if unknown.
+    uint32_t PollPeriod();
+    uint SampleCount();
+    uint32_t SampleSpacing();
+    // Time by which the given sample of the current loop should start.
+    uint32_t SampleDeadline(uint sample);
+    // Predicted start of the next poll. Only meaningful once locked on.
+    uint32_t NextPollTime();
+    // Whether a sample started now would be ready before the next poll. Always true while
+    // detecting, as samples aren't scheduled then.
+    bool SampleFitsBeforePoll(uint32_t now_us);
+    uint32_t PollLead();
+
+    // To be called just before waiting for the poll. Counts a late poll if the poll was predicted
+    // to have started already.
+    void StartWaitForPoll(uint32_t now_us);
+    // To be called when the poll is seen to start, so that the poll lead can be measured.
+    void RecordPollStart(uint32_t now_us);
+    // To be called when a poll wasn't answered. The poll may not have been a real one, e.g. noise on
+    // the line, so the next loop start is taken on trust: the prediction is kept instead of being
+    // corrected from it, and it doesn't count against the lock.
+    void RecordMissedPoll();
+    void RecordSkippedSamples(uint count);
+
+    uint32_t LatePolls();
+    uint32_t MissedPolls();
+    uint32_t SkippedSamples();
+
+    // Time budgeted from the start of a sample until its report is ready.
+    uint32_t ComputationTime();
+    // Feeds the time the caller took to process a sample into the calibration.
+    void RecordComputationTime(uint32_t duration_us);
+    // Starts calibrating from scratch, for when the work done per sample has changed.
+    void ResetComputationTime();
+    void SetSafetyMargin(uint32_t margin_us);
+    // Fixes the budget instead of calibrating it, or calibrates again if 0.
+    void SetSampleOffset(uint32_t offset_us);
+    // Target time between samples, 1000us by default, or 0 for the default. Samples are never
+    // closer together than the fastest sample loop or the computation time budget allow.
+    void SetSampleInterval(uint32_t interval_us);
+
+    // Discards the poll timing and locks on again from scratch.
+    void Redetect();
+
+  private:
+    uint32_t _fastest_sample_us;
+    uint32_t _default_computation_time_us;
+    uint _max_sample_count;
+    uint32_t _default_poll_lead_us;
+    uint32_t _sample_interval_us;
+
+    uint32_t _sample_offset_us;
+    uint32_t _safety_margin_us;
+    // Samples measured since the calibration was reset, up to the number needed.
+    uint _calibration_samples;
+    // Longest recent sample duration.
+    uint32_t _worst_computation_us;
+    uint8_t _decay_count;
+
+    // Whether the poll start of the previous loop was recorded.
+    bool _poll_started;
+    uint32_t _poll_start;
+    bool _poll_lead_measured;
+    // Longest recent poll lead.
+    uint32_t _worst_poll_lead_us;
+    uint8_t _poll_lead_decay_count;
+
+    uint32_t _late_polls;
+    uint32_t _missed_polls;
+    // Whether the poll of the current loop went unanswered.
+    bool _poll_missed;
+    uint32_t _skipped_samples;
+
+    bool _started;
+    // Filtered start time of the current loop.
+    uint32_t _loop_start;
+    // Filtered poll period in 1/16us.
+    uint32_t _period_q4;
+    // Consecutive loops that matched the prediction, up to the number needed to lock.
+    uint _lock_count;
+    // Goes up by 2 for each loop that missed a poll or didn't match the prediction, and down by 1
+    // for each one that did.
+    uint _miss_score;
+
+    uint32_t _schedule_period;
+    uint32_t _schedule_min_spacing;
+    uint _sample_count;
+    uint32_t _sample_spacing;
+
+    uint32_t MinSampleSpacing();
+    void UpdateSchedule(uint32_t period);
+};
+
+#endif
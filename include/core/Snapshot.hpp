@@ -0,0 +1,47 @@
+#ifndef _CORE_SNAPSHOT_HPP
+#define _CORE_SNAPSHOT_HPP
+
+#include "stdlib.hpp"
+
+/*
+ * Hands the latest value of something over from the core that produces it to another, e.g. inputs
+ * read on the second core. Publishing never waits, and neither does reading, unless a value was
+ * published twice while it was being read, in which case the read is repeated.
+ *
+ * Values are written to two buffers in turn. A sequence number goes up by one when a write starts
+ * and again when it ends, which tells readers which buffer holds the latest complete value and
+ * whether it was overwritten while they copied it. There must only be one producer.
+ */
+template <typename T> class Snapshot {
+  public:
+    Snapshot() : _sequence(0) {}
+
+    void Publish(const T &value) {
+        const uint32_t sequence = _sequence;
+        _sequence = sequence + 1;
+        memory_barrier();
+        _buffers[((sequence >> 1) + 1) & 1] = value;
+        memory_barrier();
+        _sequence = sequence + 2;
+    }
+
+    T Read() const {
+        while (true) {
+            const uint32_t sequence = _sequence;
+            memory_barrier();
+            const T value = _buffers[(sequence >> 1) & 1];
+            memory_barrier();
+            // The buffer read from is written again by the write after the one that was in
+            // progress or next to start.
+            if (_sequence - sequence <= 2 - (sequence & 1)) {
+                return value;
+            }
+        }
+    }
+
+  private:
+    volatile uint32_t _sequence;
+    T _buffers[2];
+};
+
+#endif
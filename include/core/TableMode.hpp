@@ -0,0 +1,120 @@
+#ifndef _CORE_TABLEMODE_HPP
+#define _CORE_TABLEMODE_HPP
+
+#include "core/ControllerMode.hpp"
+#include "core/state.hpp"
+#include "stdlib.hpp"
+
+// Mode tables are constant and live in flash. On AVR that takes PROGMEM and explicit flash reads,
+// elsewhere flash is memory mapped, but they're copied to RAM anyway as they're on the hot path.
+#ifdef __AVR__
+#include <avr/pgmspace.h>
+#define MODE_TABLE PROGMEM
+#else
+#define MODE_TABLE RAM_DATA("mode_tables")
+#endif
+
+// Drives a digital output from an input while a layer is active. A layer is active when all of
+// layer_held are held and none of layer_released are. Mappings targeting the same output are ORed.
+// The input and output are kept as bit positions rather than masks to keep the rows small.
+typedef struct {
+    InputBit input;
+    OutputBit output;
+    uint32_t layer_held;
+    uint32_t layer_released;
+} OutputMapping;
+
+constexpr OutputMapping remap(
+    InputBit input,
+    OutputBit output,
+    uint32_t layer_held = 0,
+    uint32_t layer_released = 0
+) {
+    return { input, output, layer_held, layer_released };
+}
+
+// Quadrant-level stick states that coordinate rows can be conditioned on.
+enum StickCondition : uint8_t {
+    STICK_HORIZONTAL = 1 << 0,
+    STICK_VERTICAL = 1 << 1,
+    STICK_DIAGONAL = 1 << 2,
+    STICK_LEFT = 1 << 3,
+    STICK_DOWN = 1 << 4,
+    CSTICK_HORIZONTAL = 1 << 5,
+    CSTICK_VERTICAL = 1 << 6,
+};
+
+enum StickAxis : uint8_t {
+    AXIS_LEFT_X = 1 << 0,
+    AXIS_LEFT_Y = 1 << 1,
+    AXIS_RIGHT_X = 1 << 2,
+    AXIS_RIGHT_Y = 1 << 3,
+};
+
+// Sets the given axes to neutral + direction * magnitude while a layer is active, all of the `when`
+// conditions hold and none of the `unless` conditions do. x is the magnitude for the X axes and y
+// for the Y axes. Rows are applied in order, so later rows take precedence.
+typedef struct {
+    uint32_t layer_held;
+    uint32_t layer_released;
+    uint8_t when;
+    uint8_t unless;
+    uint8_t axes;
+    uint8_t x;
+    uint8_t y;
+} CoordinateRow;
+
+// Conditions left out are 0, i.e. the row always applies.
+constexpr CoordinateRow coords(
+    uint8_t axes,
+    uint8_t x,
+    uint8_t y,
+    uint32_t layer_held = 0,
+    uint32_t layer_released = 0,
+    uint8_t when = 0,
+    uint8_t unless = 0
+) {
+    return { layer_held, layer_released, when, unless, axes, x, y };
+}
+
+typedef struct {
+    // Inputs that drive each stick direction. A direction is active if any of its inputs are held.
+    uint32_t left;
+    uint32_t right;
+    uint32_t down;
+    uint32_t up;
+    uint32_t c_left;
+    uint32_t c_right;
+    uint32_t c_down;
+    uint32_t c_up;
+    uint8_t analog_stick_min;
+    uint8_t analog_stick_neutral;
+    uint8_t analog_stick_max;
+
+    const OutputMapping *output_mappings;
+    size_t output_mapping_count;
+    const CoordinateRow *coordinate_rows;
+    size_t coordinate_row_count;
+
+    // Analog value of a trigger whose digital output is pressed, or 0 to leave analog triggers alone.
+    uint8_t trigger_analog;
+    // Whether a connected nunchuk's stick overrides the left stick.
+    bool nunchuk_left_stick;
+} TableModeLayout;
+
+// Controller mode described entirely by a TableModeLayout, evaluated by a generic branch-light
+// evaluator.
+class TableMode : public ControllerMode {
+  public:
+    // The layout isn't copied, so it must outlive the mode.
+    TableMode(const TableModeLayout &layout);
+    bool isMelee();
+
+  protected:
+    const TableModeLayout &_layout;
+
+    void UpdateDigitalOutputs(InputState &inputs, OutputState &outputs);
+    void UpdateAnalogOutputs(InputState &inputs, OutputState &outputs);
+};
+
+#endif
@@ -15,29 +15,53 @@ namespace socd {
     } SocdType;
 
     typedef struct {
-        bool InputState::*input_dir1;
-        bool InputState::*input_dir2;
+        InputBit input_dir1;
+        InputBit input_dir2;
         SocdType socd_type = SOCD_NEUTRAL;
     } SocdPair;
 
+    /*
+     * The resolvers below work on many pairs at once. Each pair occupies one lane: the bit of its
+     * dir1 input in the packed button word. dir2 inputs are shifted down into their pair's lane
+     * beforehand, so every bit of every word refers to the same pair throughout.
+     */
+
+    // Per-lane state of the second input priority resolvers.
     typedef struct {
-        bool was_dir1 = false;
-        bool was_dir2 = false;
-        bool lock_dir1 = false;
-        bool lock_dir2 = false;
+        uint32_t was_dir1 = 0;
+        uint32_t was_dir2 = 0;
+        uint32_t lock_dir1 = 0;
+        uint32_t lock_dir2 = 0;
     } SocdState;
 
+    // Pairs that share a resolver type and dir2 offset, and so can be resolved in one pass.
+    typedef struct {
+        uint32_t lanes;
+        // Position of dir2 relative to dir1 in the button word.
+        int8_t shift;
+        SocdType socd_type;
+        SocdState state;
+    } SocdGroup;
+
+    // Splits pairs into groups, which are resolved in order, preserving the order in which pairs
+    // that share an input are resolved. There are never more groups than pairs, so groups must
+    // have room for pair_count of them. Returns the number of groups used.
+    size_t compile_groups(const SocdPair *pairs, size_t pair_count, SocdGroup *groups);
+
+    // Resolves all groups against the packed button word.
+    uint32_t resolve(uint32_t buttons, SocdGroup *groups, size_t group_count);
+
     void second_input_priority_no_reactivation(
-        bool &input_dir1,
-        bool &input_dir2,
+        uint32_t &input_dir1,
+        uint32_t &input_dir2,
         SocdState &socd_state
     );
 
-    void second_input_priority(bool &input_dir1, bool &input_dir2, SocdState &socd_state);
+    void second_input_priority(uint32_t &input_dir1, uint32_t &input_dir2, SocdState &socd_state);
 
-    void neutral(bool &input_dir1, bool &input_dir2);
+    void neutral(uint32_t &input_dir1, uint32_t &input_dir2);
 
-    void dir1_priority(bool &input_dir1, bool &input_dir2);
+    void dir1_priority(uint32_t &input_dir1, uint32_t &input_dir2);
 }
 
 #endif
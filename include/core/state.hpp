@@ -3,38 +3,90 @@
 
 #include "stdlib.hpp"
 
-// Button state.
+// Bit positions of the digital inputs within InputState::buttons. Must stay in the same order as
+// the bitfields declared in InputState.
+enum class InputBit : uint8_t {
+    left,
+    right,
+    down,
+    up,
+    c_left,
+    c_right,
+    c_down,
+    c_up,
+    a,
+    b,
+    x,
+    y,
+    l,
+    r,
+    z,
+    lightshield,
+    midshield,
+    select,
+    start,
+    home,
+    mod_x,
+    mod_y,
+    nunchuk_connected,
+    nunchuk_c,
+    nunchuk_z,
+    none,
+};
+
+constexpr uint32_t input_mask(InputBit bit) {
+    return bit == InputBit::none ? 0 : (uint32_t)1 << (uint8_t)bit;
+}
+
+template <typename... Bits> constexpr uint32_t input_mask(InputBit bit, Bits... bits) {
+    return input_mask(bit) | input_mask(bits...);
+}
+
+// Button state. All digital inputs are packed into a single word so that they can be scanned,
+// compared and masked as a whole, while still being accessible by name.
 typedef struct inputstate {
-    // Rectangle inputs.
-    bool left = false;
-    bool right = false;
-    bool down = false;
-    bool up = false;
-    bool c_left = false;
-    bool c_right = false;
-    bool c_down = false;
-    bool c_up = false;
-    bool a = false;
-    bool b = false;
-    bool x = false;
-    bool y = false;
-    bool l = false;
-    bool r = false;
-    bool z = false;
-    bool lightshield = false;
-    bool midshield = false;
-    bool select = false;
-    bool start = false;
-    bool home = false;
-    bool mod_x = false;
-    bool mod_y = false;
+    union {
+        struct {
+            // Rectangle inputs.
+            bool left : 1;
+            bool right : 1;
+            bool down : 1;
+            bool up : 1;
+            bool c_left : 1;
+            bool c_right : 1;
+            bool c_down : 1;
+            bool c_up : 1;
+            bool a : 1;
+            bool b : 1;
+            bool x : 1;
+            bool y : 1;
+            bool l : 1;
+            bool r : 1;
+            bool z : 1;
+            bool lightshield : 1;
+            bool midshield : 1;
+            bool select : 1;
+            bool start : 1;
+            bool home : 1;
+            bool mod_x : 1;
+            bool mod_y : 1;
+
+            // Nunchuk buttons.
+            bool nunchuk_connected : 1;
+            bool nunchuk_c : 1;
+            bool nunchuk_z : 1;
+        };
+        uint32_t buttons = 0;
+    };
 
-    // Nunchuk inputs.
-    bool nunchuk_connected = false;
+    // Nunchuk stick.
     int8_t nunchuk_x = 0;
     int8_t nunchuk_y = 0;
-    bool nunchuk_c = false;
-    bool nunchuk_z = false;
+
+    // When the buttons last changed, from a free-running microsecond clock. Only input sources that
+    // are scanned continuously keep track of it, and they set change_timed.
+    bool change_timed = false;
+    uint32_t changed_us = 0;
 } InputState;
 
 // State describing stick direction at the quadrant level.
@@ -48,26 +100,57 @@ typedef struct {
     int8_t cy;
 } StickDirections;
 
+// Bit positions of the digital outputs within OutputState::digital. Must stay in the same order as
+// the bitfields declared in OutputState.
+enum class OutputBit : uint8_t {
+    a,
+    b,
+    x,
+    y,
+    buttonL,
+    buttonR,
+    triggerLDigital,
+    triggerRDigital,
+    start,
+    select,
+    home,
+    dpadUp,
+    dpadDown,
+    dpadLeft,
+    dpadRight,
+    leftStickClick,
+    rightStickClick,
+};
+
+constexpr uint32_t output_mask(OutputBit bit) {
+    return (uint32_t)1 << (uint8_t)bit;
+}
+
 // Output state.
 typedef struct outputstate {
-    // Digital outputs.
-    bool a = false;
-    bool b = false;
-    bool x = false;
-    bool y = false;
-    bool buttonL = false;
-    bool buttonR = false;
-    bool triggerLDigital = false;
-    bool triggerRDigital = false;
-    bool start = false;
-    bool select = false;
-    bool home = false;
-    bool dpadUp = false;
-    bool dpadDown = false;
-    bool dpadLeft = false;
-    bool dpadRight = false;
-    bool leftStickClick = false;
-    bool rightStickClick = false;
+    // Digital outputs, packed the same way as InputState::buttons.
+    union {
+        struct {
+            bool a : 1;
+            bool b : 1;
+            bool x : 1;
+            bool y : 1;
+            bool buttonL : 1;
+            bool buttonR : 1;
+            bool triggerLDigital : 1;
+            bool triggerRDigital : 1;
+            bool start : 1;
+            bool select : 1;
+            bool home : 1;
+            bool dpadUp : 1;
+            bool dpadDown : 1;
+            bool dpadLeft : 1;
+            bool dpadRight : 1;
+            bool leftStickClick : 1;
+            bool rightStickClick : 1;
+        };
+        uint32_t digital = 0;
+    };
 
     // Analog outputs.
     uint8_t leftStickX = 128;
@@ -78,4 +161,11 @@ typedef struct outputstate {
     uint8_t triggerLAnalog = 0;
 } OutputState;
 
+inline bool same_outputs(const OutputState &a, const OutputState &b) {
+    return a.digital == b.digital && a.leftStickX == b.leftStickX &&
+           a.leftStickY == b.leftStickY && a.rightStickX == b.rightStickX &&
+           a.rightStickY == b.rightStickY && a.triggerRAnalog == b.triggerRAnalog &&
+           a.triggerLAnalog == b.triggerLAnalog;
+}
+
 #endif
\ No newline at end of file
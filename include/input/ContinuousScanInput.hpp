@@ -0,0 +1,48 @@
+#ifndef _INPUT_CONTINUOUSSCANINPUT_HPP
+#define _INPUT_CONTINUOUSSCANINPUT_HPP
+
+#include "core/InputSource.hpp"
+#include "core/Snapshot.hpp"
+#include "core/state.hpp"
+#include "stdlib.hpp"
+
+typedef struct {
+    bool scanned = false;
+    uint32_t buttons = 0;
+    uint32_t changed_us = 0;
+} ScannedButtons;
+
+/*
+ * Scans the buttons of another input source, such as a GpioButtonInput or SwitchMatrixInput, by
+ * calling Scan() in a tight loop on the second core. Each change is timestamped as it's seen and
+ * handed over with the buttons, so UpdateInputs() costs no scan at all and tells the backend when
+ * the buttons it reads last changed, to within one pass of the loop.
+ *
+ * Until Scan() is first called, UpdateInputs() scans the source itself as usual. The first call
+ * asks for the scanning to be handed over, and UpdateInputs() hands it over after its next scan,
+ * so the source is never scanned from both places at once.
+ */
+class ContinuousScanInput : public InputSource {
+  public:
+    // The source should only be scanned through this from now on.
+    ContinuousScanInput(InputSource *source);
+    InputScanSpeed ScanSpeed();
+    void UpdateInputs(InputState &inputs);
+    uint32_t ButtonMask();
+    // Scans the source once, and passes the buttons on if they changed. Does nothing until
+    // UpdateInputs() has handed the scanning over.
+    void Scan();
+
+  private:
+    InputSource *_source;
+    uint32_t _button_mask;
+    InputState _scan_inputs;
+    volatile bool _scan_requested;
+    volatile bool _scanning;
+    // What was last passed on, if anything yet.
+    bool _published;
+    uint32_t _buttons;
+    Snapshot<ScannedButtons> _scanned;
+};
+
+#endif
@@ -6,19 +6,31 @@
 #include "stdlib.hpp"
 
 typedef struct {
-    bool InputState::*button;
+    InputBit button;
     uint pin;
 } GpioButtonMapping;
 
+// One button of the precomputed scan plan: which port it is read from, its bit within that port,
+// and the bit it sets in InputState::buttons when pressed.
+typedef struct {
+    uint8_t port;
+    uint32_t pin_mask;
+    uint32_t button_mask;
+} GpioScanStep;
+
 class GpioButtonInput : public InputSource {
   public:
     GpioButtonInput(GpioButtonMapping *button_mappings, size_t button_count);
+    ~GpioButtonInput();
     InputScanSpeed ScanSpeed();
     void UpdateInputs(InputState &inputs);
+    uint32_t ButtonMask();
 
   protected:
     GpioButtonMapping *_button_mappings;
     size_t _button_count;
+    uint32_t _button_mask;
+    GpioScanStep *_scan_steps;
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -5,15 +5,15 @@
 #include "core/state.hpp"
 #include "gpio.hpp"
 
-#define BTN(x) &InputState::x
-#define NA nullptr
+#define BTN(x) InputBit::x
+#define NA InputBit::none
 
 enum class DiodeDirection {
     ROW2COL,
     COL2ROW,
 };
 
-typedef bool InputState::*SwitchMatrixElement;
+typedef InputBit SwitchMatrixElement;
 
 template <size_t num_rows, size_t num_cols> class SwitchMatrixInput : public InputSource {
   public:
@@ -26,6 +26,13 @@ template <size_t num_rows, size_t num_cols> class SwitchMatrixInput : public Inp
         : _matrix(matrix) {
         _direction = direction;
 
+        _button_mask = 0;
+        for (size_t i = 0; i < num_rows; i++) {
+            for (size_t j = 0; j < num_cols; j++) {
+                _button_mask |= input_mask(_matrix[i][j]);
+            }
+        }
+
         if (_direction == DiodeDirection::ROW2COL) {
             _num_outputs = num_cols;
             _num_inputs = num_rows;
@@ -58,7 +65,10 @@ template <size_t num_rows, size_t num_cols> class SwitchMatrixInput : public Inp
 
     InputScanSpeed ScanSpeed() { return InputScanSpeed::FAST; }
 
+    uint32_t ButtonMask() { return _button_mask; }
+
     void UpdateInputs(InputState &inputs) {
+        uint32_t pressed = 0;
         for (size_t i = 0; i < _num_outputs; i++) {
             // Activate the column/row.
             gpio::init_pin(_output_pins[i], gpio::GpioMode::GPIO_OUTPUT);
@@ -68,14 +78,15 @@ template <size_t num_rows, size_t num_cols> class SwitchMatrixInput : public Inp
             for (size_t j = 0; j < _num_inputs; j++) {
                 SwitchMatrixElement button =
                     _direction == DiodeDirection::ROW2COL ? _matrix[j][i] : _matrix[i][j];
-                if (button != nullptr) {
-                    inputs.*button = !gpio::read_digital(_input_pins[j]);
+                if (button != NA && !gpio::read_digital(_input_pins[j])) {
+                    pressed |= input_mask(button);
                 }
             }
 
             // Deactivate the column/row.
             gpio::init_pin(_output_pins[i], gpio::GpioMode::GPIO_INPUT_PULLUP);
         }
+        inputs.buttons = (inputs.buttons & ~_button_mask) | pressed;
     }
 
   protected:
@@ -85,6 +96,7 @@ template <size_t num_rows, size_t num_cols> class SwitchMatrixInput : public Inp
     uint *_input_pins;
     SwitchMatrixElement (&_matrix)[num_rows][num_cols];
     DiodeDirection _direction;
+    uint32_t _button_mask;
 };
 
 #endif
\ No newline at end of file
@@ -10,10 +10,111 @@
 
 enum abtest{AB_A, AB_B};
 
-void limitOutputs(const uint16_t sampleSpacing,
-                  const abtest whichAB,
-                  const InputState &inputs,
-                  const OutputState &rawOutput,
-                  OutputState &finalOutput);
+#define HISTORYLEN 5//changes in target stick position
+
+enum travelType{T_Lin, T_Quad, T_Cubic, T_Quart, T_Delay};
+
+typedef struct {
+    uint32_t timestamp;//in us
+    uint8_t tt;//travel time used in ms
+    uint8_t x;
+    uint8_t y;
+    uint8_t x_start;
+    uint8_t y_start;
+    uint8_t x_end;
+    uint8_t y_end;
+} shortstate;
+
+//for sdi nerfs, we want to record only movement between sdi zones, ignoring movement within zones
+typedef struct {
+    uint32_t timestamp;//in us
+    uint8_t zone;
+    bool stale;
+} sdizonestate;
+
+//for pivot nerfs, we want to record only movement between dash zones, ignoring movement within zones
+typedef struct {
+    uint32_t timestamp;//in us
+    uint8_t zone;
+    bool stale;
+} pivotzonestate;
+
+typedef struct {
+    uint16_t value;
+    bool seeded;//seeded from the time of the first randomized coordinate
+} randomstate;
+
+//everything the limiter remembers between samples; plain data, so it can be copied freely
+typedef struct {
+    bool initialized;//the rest is set up from the first sample after a reset
+    uint32_t prevTime;
+    uint32_t prevButtons;
+    uint8_t prevX;
+    uint8_t prevY;
+
+    shortstate aHistory[HISTORYLEN];
+    sdizonestate sdiZoneHist[HISTORYLEN];
+    pivotzonestate pivotZoneHist[HISTORYLEN];
+    uint8_t currentIndexA;
+    uint8_t currentIndexSDI;
+
+    travelType delayType;
+    bool doneTraveling;
+    bool wavedashWasNerfed;
+    bool sdiIsNerfed;
+    bool downUpJumping;
+    //in us, only counted up to the time limits
+    uint32_t sdiCountdown;
+    uint32_t timeSinceNotUptilt;
+    uint32_t timeSinceCrouch;
+    uint32_t timeSinceJump;
+
+    randomstate random;
+
+    //the raw outputs of the previous sample
+    OutputState prevRaw;
+    //set when a full pass over unchanged inputs left the state as it was, apart from the timers in
+    //quietCounting counting up: the same inputs then give the same outputs until quietFor has passed
+    //since quietSince, when a time limit could be reached
+    bool quiet;
+    uint8_t quietCounting;
+    uint32_t quietSince;
+    uint32_t quietFor;
+    OutputState quietOutput;
+} MeleeLimiterState;
+
+/*
+ * Applies the Melee nerfs to a stream of samples. All of its history is kept in one
+ * MeleeLimiterState, so a limiter can be reset, and its state saved and restored to run samples
+ * ahead speculatively or through more than one limiter.
+ *
+ * Most samples repeat the previous one's inputs once the stick has finished traveling. Those are
+ * answered from the last result until one of the time limits could change it, which gives the same
+ * outputs as working them out in full.
+ */
+class MeleeLimiter {
+  public:
+    MeleeLimiter();
+
+    //sampleTimeUs: when the inputs were sampled, from a free-running microsecond clock
+    void LimitOutputs(const uint32_t sampleTimeUs,
+                      const abtest whichAB,
+                      const InputState &inputs,
+                      const OutputState &rawOutput,
+                      OutputState &finalOutput);
+
+    //forgets all history, e.g. when the mode changes
+    void Reset();
+    const MeleeLimiterState &SaveState() const;
+    void Restore(const MeleeLimiterState &state);
+
+  private:
+    MeleeLimiterState _state;
+
+    void ComputeOutputs(const uint32_t sampleTimeUs,
+                        const InputState &inputs,
+                        const OutputState &rawOutput,
+                        OutputState &finalOutput);
+};
 
 #endif
@@ -1,17 +1,12 @@
 #ifndef _MODES_DARKSOULS_HPP
 #define _MODES_DARKSOULS_HPP
 
-#include "core/ControllerMode.hpp"
+#include "core/TableMode.hpp"
 #include "core/socd.hpp"
-#include "core/state.hpp"
 
-class DarkSouls : public ControllerMode {
+class DarkSouls : public TableMode {
   public:
     DarkSouls(socd::SocdType socd_type);
-
-  private:
-    void UpdateDigitalOutputs(InputState &inputs, OutputState &outputs);
-    void UpdateAnalogOutputs(InputState &inputs, OutputState &outputs);
 };
 
 #endif
@@ -1,17 +1,12 @@
 #ifndef _MODES_MKWII_HPP
 #define _MODES_MKWII_HPP
 
-#include "core/ControllerMode.hpp"
+#include "core/TableMode.hpp"
 #include "core/socd.hpp"
-#include "core/state.hpp"
 
-class MKWii : public ControllerMode {
+class MKWii : public TableMode {
   public:
     MKWii(socd::SocdType socd_type);
-
-  private:
-    void UpdateDigitalOutputs(InputState &inputs, OutputState &outputs);
-    void UpdateAnalogOutputs(InputState &inputs, OutputState &outputs);
 };
 
 #endif
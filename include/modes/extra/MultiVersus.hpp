@@ -1,17 +1,12 @@
 #ifndef _MODES_MULTIVERSUS_HPP
 #define _MODES_MULTIVERSUS_HPP
 
-#include "core/ControllerMode.hpp"
+#include "core/TableMode.hpp"
 #include "core/socd.hpp"
-#include "core/state.hpp"
 
-class MultiVersus : public ControllerMode {
+class MultiVersus : public TableMode {
   public:
     MultiVersus(socd::SocdType socd_type);
-
-  protected:
-    virtual void UpdateDigitalOutputs(InputState &inputs, OutputState &outputs);
-    virtual void UpdateAnalogOutputs(InputState &inputs, OutputState &outputs);
 };
 
 #endif
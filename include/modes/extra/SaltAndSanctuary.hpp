@@ -1,17 +1,12 @@
 #ifndef _MODES_SALTANDSANCTUARY_HPP
 #define _MODES_SALTANDSANCTUARY_HPP
 
-#include "core/ControllerMode.hpp"
+#include "core/TableMode.hpp"
 #include "core/socd.hpp"
-#include "core/state.hpp"
 
-class SaltAndSanctuary : public ControllerMode {
+class SaltAndSanctuary : public TableMode {
   public:
     SaltAndSanctuary(socd::SocdType socd_type);
-
-  private:
-    void UpdateDigitalOutputs(InputState &inputs, OutputState &outputs);
-    void UpdateAnalogOutputs(InputState &inputs, OutputState &outputs);
 };
 
 #endif
@@ -1,16 +1,15 @@
 #ifndef _MODES_ULTIMATE_HPP
 #define _MODES_ULTIMATE_HPP
 
-#include "core/ControllerMode.hpp"
+#include "core/TableMode.hpp"
 #include "core/socd.hpp"
 #include "core/state.hpp"
 
-class Ultimate2 : public ControllerMode {
+class Ultimate2 : public TableMode {
   public:
     Ultimate2(socd::SocdType socd_type);
 
   private:
-    void UpdateDigitalOutputs(InputState &inputs, OutputState &outputs);
     void UpdateAnalogOutputs(InputState &inputs, OutputState &outputs);
 };
 
@@ -14,13 +14,13 @@ InputState &CommunicationBackend::GetInputs() {
     return _inputs;
 }
 
-void CommunicationBackend::ScanInputs() {
+void RAM_FUNC(CommunicationBackend::ScanInputs)() {
     for (size_t i = 0; i < _input_source_count; i++) {
         _input_sources[i]->UpdateInputs(_inputs);
     }
 }
 
-void CommunicationBackend::ScanInputs(InputScanSpeed input_source_filter) {
+void RAM_FUNC(CommunicationBackend::ScanInputs)(InputScanSpeed input_source_filter) {
     for (size_t i = 0; i < _input_source_count; i++) {
         InputSource *input_source = _input_sources[i];
         if (input_source->ScanSpeed() == input_source_filter) {
@@ -29,11 +29,11 @@ void CommunicationBackend::ScanInputs(InputScanSpeed input_source_filter) {
     }
 }
 
-void CommunicationBackend::ResetOutputs() {
+void RAM_FUNC(CommunicationBackend::ResetOutputs)() {
     _outputs = OutputState();
 }
 
-void CommunicationBackend::UpdateOutputs() {
+void RAM_FUNC(CommunicationBackend::UpdateOutputs)() {
     ResetOutputs();
     if (_gamemode != nullptr) {
         _gamemode->UpdateOutputs(_inputs, _outputs);
@@ -5,13 +5,13 @@ ControllerMode::ControllerMode() {
     ResetDirections();
 }
 
-void ControllerMode::UpdateOutputs(InputState &inputs, OutputState &outputs) {
+void RAM_FUNC(ControllerMode::UpdateOutputs)(InputState &inputs, OutputState &outputs) {
     HandleSocd(inputs);
     UpdateDigitalOutputs(inputs, outputs);
     UpdateAnalogOutputs(inputs, outputs);
 }
 
-void ControllerMode::ResetDirections() {
+void RAM_FUNC(ControllerMode::ResetDirections)() {
     directions = {
         .horizontal = false,
         .vertical = false,
@@ -23,7 +23,7 @@ void ControllerMode::ResetDirections() {
     };
 }
 
-void ControllerMode::UpdateDirections(
+void RAM_FUNC(ControllerMode::UpdateDirections)(
     bool lsLeft,
     bool lsRight,
     bool lsDown,
@@ -6,49 +6,15 @@
 InputMode::InputMode() {}
 
 InputMode::~InputMode() {
-    delete[] _socd_pairs;
-    delete[] _socd_states;
+    delete[] _socd_groups;
 }
 
-void InputMode::HandleSocd(InputState &inputs) {
-    if (_socd_pairs == nullptr) {
-        return;
-    }
-
-    // Initialize SOCD states if they aren't initialized.
-    if (_socd_states == nullptr) {
-        _socd_states = new socd::SocdState[_socd_pair_count];
-    }
+void InputMode::SetSocdPairs(const socd::SocdPair *pairs, size_t pair_count) {
+    delete[] _socd_groups;
+    _socd_groups = new socd::SocdGroup[pair_count];
+    _socd_group_count = socd::compile_groups(pairs, pair_count, _socd_groups);
+}
 
-    // Handle SOCD resolution for each SOCD button pair.
-    for (size_t i = 0; i < _socd_pair_count; i++) {
-        socd::SocdPair pair = _socd_pairs[i];
-        switch (pair.socd_type) {
-            case socd::SOCD_NEUTRAL:
-                socd::neutral(inputs.*(pair.input_dir1), inputs.*(pair.input_dir2));
-                break;
-            case socd::SOCD_2IP:
-                socd::second_input_priority(
-                    inputs.*(pair.input_dir1),
-                    inputs.*(pair.input_dir2),
-                    _socd_states[i]
-                );
-                break;
-            case socd::SOCD_2IP_NO_REAC:
-                socd::second_input_priority_no_reactivation(
-                    inputs.*(pair.input_dir1),
-                    inputs.*(pair.input_dir2),
-                    _socd_states[i]
-                );
-                break;
-            case socd::SOCD_DIR1_PRIORITY:
-                socd::dir1_priority(inputs.*(pair.input_dir1), inputs.*(pair.input_dir2));
-                break;
-            case socd::SOCD_DIR2_PRIORITY:
-                socd::dir1_priority(inputs.*(pair.input_dir2), inputs.*(pair.input_dir1));
-                break;
-            case socd::SOCD_NONE:
-                break;
-        }
-    }
+void RAM_FUNC(InputMode::HandleSocd)(InputState &inputs) {
+    inputs.buttons = socd::resolve(inputs.buttons, _socd_groups, _socd_group_count);
 }
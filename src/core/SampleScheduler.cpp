@@ -0,0 +1,286 @@
+#include "core/SampleScheduler.hpp"
+
+// Consecutive loops that must match the prediction before samples are scheduled.
+#define LOCK_LOOPS 4
+// Missed or mistimed loops in a row after which the poll timing is measured again. Each one that
+// lines up with the prediction forgives half of one.
+#define MAX_MISSES 4
+// Anything faster than about 3300 Hz (300us) is not a real poll interval.
+#define MIN_PLAUSIBLE_LOOP_US 300
+// Change in poll period that warrants recomputing the sample schedule.
+#define RESCHEDULE_THRESHOLD_US 4
+// Samples to measure before the computation time budget is calibrated.
+#define CALIBRATION_SAMPLES 64
+#define DEFAULT_SAFETY_MARGIN_US 30
+// Most a single late poll raises the computation time budget by.
+#define MAX_LATE_POLL_PENALTY_US 20
+// Longer poll leads mean the poll went unanswered and the loop started on a later one.
+#define MAX_POLL_LEAD_US 1000
+#define DEFAULT_SAMPLE_INTERVAL_US 1000
+
+// Follows a worst case up straight away, and back down by 1us every 256 updates.
+static inline void track_worst_case(uint32_t &worst, uint8_t &decay_count, uint32_t value) {
+    if (value >= worst) {
+        worst = value;
+    } else if (++decay_count == 0) {
+        worst--;
+    }
+}
+
+SampleScheduler::SampleScheduler(
+    uint32_t fastest_sample_us,
+    uint32_t computation_time_us,
+    uint32_t poll_lead_us,
+    uint max_sample_count
+) {
+    _fastest_sample_us = fastest_sample_us;
+    _default_computation_time_us = computation_time_us;
+    _default_poll_lead_us = poll_lead_us;
+    _max_sample_count = max_sample_count;
+    _sample_interval_us = DEFAULT_SAMPLE_INTERVAL_US;
+    _sample_offset_us = 0;
+    _safety_margin_us = DEFAULT_SAFETY_MARGIN_US;
+    _poll_started = false;
+    _poll_lead_measured = false;
+    _worst_poll_lead_us = 0;
+    _poll_lead_decay_count = 0;
+    _late_polls = 0;
+    _missed_polls = 0;
+    _skipped_samples = 0;
+    ResetComputationTime();
+    Redetect();
+}
+
+void SampleScheduler::StartLoop(uint32_t now_us) {
+    if (_poll_started) {
+        _poll_started = false;
+        uint32_t poll_lead = now_us - _poll_start;
+        // Ignore loops that went on to miss their poll.
+        if (poll_lead < MAX_POLL_LEAD_US) {
+            track_worst_case(_worst_poll_lead_us, _poll_lead_decay_count, poll_lead);
+            _poll_lead_measured = true;
+        }
+    }
+
+    const bool poll_missed = _poll_missed;
+    _poll_missed = false;
+
+    if (!_started) {
+        _started = true;
+        _loop_start = now_us;
+        return;
+    }
+
+    uint32_t elapsed = now_us - _loop_start;
+
+    // Without a period estimate, take the first plausible loop time as one.
+    if (_period_q4 == 0) {
+        if (elapsed > MIN_PLAUSIBLE_LOOP_US) {
+            _period_q4 = elapsed << 4;
+        }
+        _loop_start = now_us;
+        return;
+    }
+
+    // Work out how many polls have gone by, and how far off the predicted loop start this one is.
+    uint32_t period = _period_q4 >> 4;
+    uint32_t polls = (elapsed + (period >> 1)) / period;
+    int32_t error = (int32_t)(elapsed - polls * period);
+    uint32_t abs_error = error < 0 ? -error : error;
+
+    // After an unanswered poll, just follow the prediction.
+    if (poll_missed) {
+        _loop_start += polls * period;
+        return;
+    }
+
+    // Missed polls and loops that are off the prediction are tolerated now and then, but if they
+    // keep coming the poll timing has changed.
+    if (polls != 1 || abs_error > (period >> 4)) {
+        _miss_score += 2;
+        // Lock on from consecutive matching loops only.
+        if (Detecting()) {
+            _lock_count = 0;
+        }
+        if (_miss_score >= 2 * MAX_MISSES) {
+            Redetect();
+            _started = true;
+            _loop_start = now_us;
+            return;
+        }
+    } else if (_miss_score > 0) {
+        _miss_score--;
+    }
+
+    if (polls == 0 || abs_error > (period >> 4)) {
+        // Keep following the prediction through the odd late or early poll.
+        _loop_start += polls * period;
+        return;
+    }
+
+    // Correct the phase by a quarter of the error and the period by a sixteenth of it, per poll.
+    _loop_start += polls * period + error / 4;
+    _period_q4 += error / (int32_t)polls;
+    if (_lock_count < LOCK_LOOPS) {
+        _lock_count++;
+    }
+
+    // Only reschedule for changes beyond the usual jitter, as it takes a few divisions.
+    period = _period_q4 >> 4;
+    uint32_t period_change = period > _schedule_period ? period - _schedule_period
+                                                       : _schedule_period - period;
+    uint32_t min_spacing = MinSampleSpacing();
+    uint32_t min_spacing_change = min_spacing > _schedule_min_spacing
+                                      ? min_spacing - _schedule_min_spacing
+                                      : _schedule_min_spacing - min_spacing;
+    if (!Detecting() &&
+        (period_change > RESCHEDULE_THRESHOLD_US || min_spacing_change > RESCHEDULE_THRESHOLD_US)) {
+        UpdateSchedule(period);
+    }
+}
+
+bool RAM_FUNC(SampleScheduler::Detecting)() {
+    return _lock_count < LOCK_LOOPS;
+}
+
+uint32_t SampleScheduler::PollPeriod() {
+    return _period_q4 >> 4;
+}
+
+uint RAM_FUNC(SampleScheduler::SampleCount)() {
+    return _sample_count;
+}
+
+uint32_t SampleScheduler::SampleSpacing() {
+    return _sample_spacing;
+}
+
+uint32_t RAM_FUNC(SampleScheduler::SampleDeadline)(uint sample) {
+    return _loop_start + (sample + 1) * _sample_spacing - PollLead() - ComputationTime();
+}
+
+uint32_t RAM_FUNC(SampleScheduler::NextPollTime)() {
+    return _loop_start + _sample_count * _sample_spacing - PollLead();
+}
+
+bool RAM_FUNC(SampleScheduler::SampleFitsBeforePoll)(uint32_t now_us) {
+    return Detecting() || (int32_t)(NextPollTime() - (now_us + ComputationTime())) >= 0;
+}
+
+uint32_t RAM_FUNC(SampleScheduler::PollLead)() {
+    return _poll_lead_measured ? _worst_poll_lead_us : _default_poll_lead_us;
+}
+
+void SampleScheduler::StartWaitForPoll(uint32_t now_us) {
+    if (Detecting()) {
+        return;
+    }
+    int32_t lateness = (int32_t)(now_us - NextPollTime());
+    if (lateness > 0) {
+        _late_polls++;
+        // Budget more time so as not to be late again. Only by a little at a time, as one late poll
+        // may just be down to an interrupt.
+        if (_sample_offset_us == 0 && _calibration_samples >= CALIBRATION_SAMPLES) {
+            _worst_computation_us += lateness < MAX_LATE_POLL_PENALTY_US ? lateness
+                                                                         : MAX_LATE_POLL_PENALTY_US;
+        }
+    }
+}
+
+void SampleScheduler::RecordPollStart(uint32_t now_us) {
+    _poll_started = true;
+    _poll_start = now_us;
+}
+
+void SampleScheduler::RecordMissedPoll() {
+    _missed_polls++;
+    _poll_missed = true;
+}
+
+void SampleScheduler::RecordSkippedSamples(uint count) {
+    _skipped_samples += count;
+}
+
+uint32_t SampleScheduler::LatePolls() {
+    return _late_polls;
+}
+
+uint32_t SampleScheduler::MissedPolls() {
+    return _missed_polls;
+}
+
+uint32_t SampleScheduler::SkippedSamples() {
+    return _skipped_samples;
+}
+
+uint32_t RAM_FUNC(SampleScheduler::ComputationTime)() {
+    if (_sample_offset_us != 0) {
+        return _sample_offset_us;
+    }
+    if (_calibration_samples < CALIBRATION_SAMPLES) {
+        return _default_computation_time_us;
+    }
+    return _worst_computation_us + _safety_margin_us;
+}
+
+void RAM_FUNC(SampleScheduler::RecordComputationTime)(uint32_t duration_us) {
+    track_worst_case(_worst_computation_us, _decay_count, duration_us);
+    if (_calibration_samples < CALIBRATION_SAMPLES) {
+        _calibration_samples++;
+    }
+}
+
+void SampleScheduler::ResetComputationTime() {
+    _calibration_samples = 0;
+    _worst_computation_us = 0;
+    _decay_count = 0;
+}
+
+void SampleScheduler::SetSafetyMargin(uint32_t margin_us) {
+    _safety_margin_us = margin_us;
+}
+
+void SampleScheduler::SetSampleOffset(uint32_t offset_us) {
+    _sample_offset_us = offset_us;
+}
+
+void SampleScheduler::SetSampleInterval(uint32_t interval_us) {
+    _sample_interval_us = interval_us > 0 ? interval_us : DEFAULT_SAMPLE_INTERVAL_US;
+    if (!Detecting()) {
+        UpdateSchedule(PollPeriod());
+    }
+}
+
+void SampleScheduler::Redetect() {
+    _poll_missed = false;
+    _started = false;
+    _loop_start = 0;
+    _period_q4 = 0;
+    _lock_count = 0;
+    _miss_score = 0;
+    _schedule_period = 0;
+    _schedule_min_spacing = 0;
+    _sample_count = 1;
+    _sample_spacing = 0;
+}
+
+uint32_t SampleScheduler::MinSampleSpacing() {
+    // Samples closer together than one takes would just run back to back.
+    uint32_t computation_time = ComputationTime();
+    return computation_time > _fastest_sample_us ? computation_time : _fastest_sample_us;
+}
+
+void SampleScheduler::UpdateSchedule(uint32_t period) {
+    // Fit samples into the poll period a little closer together than the sample interval, but no
+    // more than can keep up.
+    _schedule_period = period;
+    _schedule_min_spacing = MinSampleSpacing();
+    _sample_count = period / _sample_interval_us + 1;
+    while (_sample_count > 1 && period / _sample_count < _schedule_min_spacing) {
+        _sample_count--;
+    }
+    if (_max_sample_count != 0 && _sample_count > _max_sample_count) {
+        _sample_count = _max_sample_count;
+    }
+    _sample_spacing = period / _sample_count;
+}
@@ -0,0 +1,99 @@
+#include "core/TableMode.hpp"
+
+#include "core/state.hpp"
+
+template <typename T> static inline T read_row(const T *row) {
+#ifdef __AVR__
+    T copy;
+    memcpy_P(&copy, row, sizeof(T));
+    return copy;
+#else
+    return *row;
+#endif
+}
+
+static inline bool layer_active(uint32_t buttons, uint32_t layer_held, uint32_t layer_released) {
+    return (buttons & layer_held) == layer_held && !(buttons & layer_released);
+}
+
+TableMode::TableMode(const TableModeLayout &layout) : _layout(layout) {}
+
+bool TableMode::isMelee() {
+    return false;
+}
+
+void RAM_FUNC(TableMode::UpdateDigitalOutputs)(InputState &inputs, OutputState &outputs) {
+    uint32_t buttons = inputs.buttons;
+    uint32_t digital = 0;
+    for (size_t i = 0; i < _layout.output_mapping_count; i++) {
+        OutputMapping mapping = read_row(&_layout.output_mappings[i]);
+        if ((buttons & input_mask(mapping.input)) &&
+            layer_active(buttons, mapping.layer_held, mapping.layer_released)) {
+            digital |= output_mask(mapping.output);
+        }
+    }
+    outputs.digital = digital;
+}
+
+void RAM_FUNC(TableMode::UpdateAnalogOutputs)(InputState &inputs, OutputState &outputs) {
+    uint32_t buttons = inputs.buttons;
+    uint8_t neutral = _layout.analog_stick_neutral;
+
+    UpdateDirections(
+        buttons & _layout.left,
+        buttons & _layout.right,
+        buttons & _layout.down,
+        buttons & _layout.up,
+        buttons & _layout.c_left,
+        buttons & _layout.c_right,
+        buttons & _layout.c_down,
+        buttons & _layout.c_up,
+        _layout.analog_stick_min,
+        neutral,
+        _layout.analog_stick_max,
+        outputs
+    );
+
+    uint8_t conditions = (directions.horizontal ? STICK_HORIZONTAL : 0) |
+                         (directions.vertical ? STICK_VERTICAL : 0) |
+                         (directions.diagonal ? STICK_DIAGONAL : 0) |
+                         (directions.x == -1 ? STICK_LEFT : 0) |
+                         (directions.y == -1 ? STICK_DOWN : 0) |
+                         (directions.cx != 0 ? CSTICK_HORIZONTAL : 0) |
+                         (directions.cy != 0 ? CSTICK_VERTICAL : 0);
+
+    for (size_t i = 0; i < _layout.coordinate_row_count; i++) {
+        CoordinateRow row = read_row(&_layout.coordinate_rows[i]);
+        if ((conditions & row.when) != row.when || (conditions & row.unless) ||
+            !layer_active(buttons, row.layer_held, row.layer_released)) {
+            continue;
+        }
+        if (row.axes & AXIS_LEFT_X) {
+            outputs.leftStickX = neutral + directions.x * row.x;
+        }
+        if (row.axes & AXIS_LEFT_Y) {
+            outputs.leftStickY = neutral + directions.y * row.y;
+        }
+        if (row.axes & AXIS_RIGHT_X) {
+            outputs.rightStickX = neutral + directions.cx * row.x;
+        }
+        if (row.axes & AXIS_RIGHT_Y) {
+            outputs.rightStickY = neutral + directions.cy * row.y;
+        }
+    }
+
+    if (_layout.trigger_analog != 0) {
+        if (outputs.triggerLDigital) {
+            outputs.triggerLAnalog = _layout.trigger_analog;
+        }
+        if (outputs.triggerRDigital) {
+            outputs.triggerRAnalog = _layout.trigger_analog;
+        }
+    }
+
+    // Nunchuk overrides left stick.
+    if (_layout.nunchuk_left_stick && inputs.nunchuk_connected) {
+        outputs.leftStickX = inputs.nunchuk_x;
+        outputs.leftStickY = inputs.nunchuk_y;
+    }
+}
@@ -1,84 +1,136 @@
 #include "core/socd.hpp"
 
-void socd::second_input_priority_no_reactivation(
-    bool &input_dir1,
-    bool &input_dir2,
-    SocdState &socd_state
-) {
-    bool is_dir1 = false;
-    bool is_dir2 = false;
-    if (input_dir1 && input_dir2) {
-        if (socd_state.was_dir2) {
-            is_dir1 = true;
-            is_dir2 = false;
-            socd_state.lock_dir2 = true;
+#include "core/state.hpp"
+
+// Moves bits by shift positions towards the MSB, or towards the LSB if shift is negative.
+static inline uint32_t shift_left(uint32_t bits, int8_t shift) {
+    return shift >= 0 ? bits << shift : bits >> -shift;
+}
+
+size_t socd::compile_groups(const SocdPair *pairs, size_t pair_count, SocdGroup *groups) {
+    size_t group_count = 0;
+    // Inputs touched by each group, so pairs sharing an input keep their relative order.
+    uint32_t *group_inputs = new uint32_t[pair_count]();
+
+    for (size_t i = 0; i < pair_count; i++) {
+        SocdPair pair = pairs[i];
+        if (pair.socd_type == SOCD_NONE) {
+            continue;
         }
-        if (socd_state.was_dir1) {
-            is_dir1 = false;
-            is_dir2 = true;
-            socd_state.lock_dir1 = true;
+        // Dir2 priority is dir1 priority with the directions swapped.
+        if (pair.socd_type == SOCD_DIR2_PRIORITY) {
+            pair = { pair.input_dir2, pair.input_dir1, SOCD_DIR1_PRIORITY };
         }
+
+        uint32_t lane = input_mask(pair.input_dir1);
+        uint32_t inputs = lane | input_mask(pair.input_dir2);
+        int8_t shift = (int8_t)pair.input_dir2 - (int8_t)pair.input_dir1;
+
+        // The pair can join any group after the last one that touches its inputs.
+        size_t first_candidate = 0;
+        for (size_t g = 0; g < group_count; g++) {
+            if (group_inputs[g] & inputs) {
+                first_candidate = g + 1;
+            }
+        }
+        size_t g = first_candidate;
+        while (g < group_count &&
+               (groups[g].socd_type != pair.socd_type || groups[g].shift != shift)) {
+            g++;
+        }
+        if (g == group_count) {
+            groups[g] = SocdGroup{ 0, shift, pair.socd_type, SocdState() };
+            group_count++;
+        }
+        groups[g].lanes |= lane;
+        group_inputs[g] |= inputs;
     }
-    if (!input_dir1 && input_dir2 && !socd_state.lock_dir2) {
-        is_dir1 = false;
-        is_dir2 = true;
-        socd_state.was_dir2 = true;
-        socd_state.was_dir1 = false;
-        socd_state.lock_dir1 = false;
-    }
-    if (input_dir1 && !input_dir2 && !socd_state.lock_dir1) {
-        is_dir1 = true;
-        is_dir2 = false;
-        socd_state.was_dir1 = true;
-        socd_state.was_dir2 = false;
-        socd_state.lock_dir2 = false;
-    }
-    if (!input_dir1 && !input_dir2) {
-        socd_state.was_dir2 = false;
-        socd_state.was_dir1 = false;
-        socd_state.lock_dir1 = false;
-        socd_state.lock_dir2 = false;
+
+    delete[] group_inputs;
+    return group_count;
+}
+
+uint32_t RAM_FUNC(socd::resolve)(uint32_t buttons, SocdGroup *groups, size_t group_count) {
+    for (size_t i = 0; i < group_count; i++) {
+        SocdGroup &group = groups[i];
+        uint32_t dir1 = buttons & group.lanes;
+        uint32_t dir2 = shift_left(buttons, -group.shift) & group.lanes;
+        switch (group.socd_type) {
+            case SOCD_NEUTRAL:
+                neutral(dir1, dir2);
+                break;
+            case SOCD_2IP:
+                second_input_priority(dir1, dir2, group.state);
+                break;
+            case SOCD_2IP_NO_REAC:
+                second_input_priority_no_reactivation(dir1, dir2, group.state);
+                break;
+            case SOCD_DIR1_PRIORITY:
+                dir1_priority(dir1, dir2);
+                break;
+            default:
+                break;
+        }
+        uint32_t dir2_inputs = shift_left(group.lanes, group.shift);
+        buttons = (buttons & ~(group.lanes | dir2_inputs)) | dir1 | shift_left(dir2, group.shift);
     }
+    return buttons;
+}
+
+void RAM_FUNC(socd::second_input_priority_no_reactivation)(
+    uint32_t &input_dir1,
+    uint32_t &input_dir2,
+    SocdState &socd_state
+) {
+    uint32_t both = input_dir1 & input_dir2;
+    uint32_t any = input_dir1 | input_dir2;
+    // A direction pressed on its own activates unless it's locked out.
+    uint32_t set_dir1 = input_dir1 & ~input_dir2 & ~socd_state.lock_dir1;
+    uint32_t set_dir2 = input_dir2 & ~input_dir1 & ~socd_state.lock_dir2;
+
+    // When both are held, the newer direction wins and the older one is locked out until both
+    // are released.
+    uint32_t is_dir1 = (both & socd_state.was_dir2 & ~socd_state.was_dir1) | set_dir1;
+    uint32_t is_dir2 = (both & socd_state.was_dir1) | set_dir2;
+
+    // Releasing both directions clears all state.
+    uint32_t lock_dir1 = (both & socd_state.was_dir1) | (socd_state.lock_dir1 & ~set_dir2 & any);
+    uint32_t lock_dir2 = (both & socd_state.was_dir2) | (socd_state.lock_dir2 & ~set_dir1 & any);
+    socd_state.was_dir1 = set_dir1 | (socd_state.was_dir1 & ~set_dir2 & any);
+    socd_state.was_dir2 = set_dir2 | (socd_state.was_dir2 & ~set_dir1 & any);
+    socd_state.lock_dir1 = lock_dir1;
+    socd_state.lock_dir2 = lock_dir2;
+
     input_dir1 = is_dir1;
     input_dir2 = is_dir2;
 }
 
-void socd::second_input_priority(bool &input_dir1, bool &input_dir2, SocdState &socd_state) {
-    bool is_dir1 = false;
-    bool is_dir2 = false;
-    if (input_dir1 && socd_state.was_dir2) {
-        is_dir1 = true;
-        is_dir2 = false;
-    }
-    if (input_dir2 && socd_state.was_dir1) {
-        is_dir1 = false;
-        is_dir2 = true;
-    }
-    if (!input_dir1 && input_dir2) {
-        is_dir1 = false;
-        is_dir2 = true;
-        socd_state.was_dir2 = true;
-        socd_state.was_dir1 = false;
-    }
-    if (input_dir1 && !input_dir2) {
-        is_dir1 = true;
-        is_dir2 = false;
-        socd_state.was_dir1 = true;
-        socd_state.was_dir2 = false;
-    }
+void RAM_FUNC(socd::second_input_priority)(
+    uint32_t &input_dir1,
+    uint32_t &input_dir2,
+    SocdState &socd_state
+) {
+    uint32_t both = input_dir1 & input_dir2;
+    uint32_t only_dir1 = input_dir1 & ~input_dir2;
+    uint32_t only_dir2 = input_dir2 & ~input_dir1;
+
+    // When both are held, the newer direction wins.
+    uint32_t is_dir1 = only_dir1 | (both & socd_state.was_dir2 & ~socd_state.was_dir1);
+    uint32_t is_dir2 = only_dir2 | (both & socd_state.was_dir1);
+
+    socd_state.was_dir1 = only_dir1 | (socd_state.was_dir1 & ~only_dir2);
+    socd_state.was_dir2 = only_dir2 | (socd_state.was_dir2 & ~only_dir1);
+
     input_dir1 = is_dir1;
     input_dir2 = is_dir2;
 }
 
-void socd::neutral(bool &input_dir1, bool &input_dir2) {
-    if (input_dir1 && input_dir2) {
-        input_dir1 = false;
-        input_dir2 = false;
-    }
+void RAM_FUNC(socd::neutral)(uint32_t &input_dir1, uint32_t &input_dir2) {
+    uint32_t both = input_dir1 & input_dir2;
+    input_dir1 &= ~both;
+    input_dir2 &= ~both;
 }
 
-void socd::dir1_priority(bool &input_dir1, bool &input_dir2) {
-    if (input_dir1 && input_dir2) {
-        input_dir2 = false;
-    }
+void RAM_FUNC(socd::dir1_priority)(uint32_t &input_dir1, uint32_t &input_dir2) {
+    input_dir2 &= ~input_dir1;
 }
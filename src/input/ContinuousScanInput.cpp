@@ -0,0 +1,67 @@
+#include "input/ContinuousScanInput.hpp"
+
+#include "timebase.hpp"
+
+ContinuousScanInput::ContinuousScanInput(InputSource *source) {
+    _source = source;
+    _button_mask = source->ButtonMask();
+    _scan_requested = false;
+    _scanning = false;
+    _published = false;
+    _buttons = 0;
+}
+
+InputScanSpeed ContinuousScanInput::ScanSpeed() {
+    return InputScanSpeed::FAST;
+}
+
+uint32_t ContinuousScanInput::ButtonMask() {
+    return _button_mask;
+}
+
+void RAM_FUNC(ContinuousScanInput::Scan)() {
+    if (!_scanning) {
+        _scan_requested = true;
+        return;
+    }
+    memory_barrier();
+
+    // The source samples its pins right away, so this is when the buttons were seen.
+    const uint32_t scan_time = timebase::now_us();
+    _source->UpdateInputs(_scan_inputs);
+    const uint32_t buttons = _scan_inputs.buttons & _button_mask;
+    if (_published && buttons == _buttons) {
+        return;
+    }
+    _published = true;
+    _buttons = buttons;
+
+    ScannedButtons scanned;
+    scanned.scanned = true;
+    scanned.buttons = buttons;
+    scanned.changed_us = scan_time;
+    _scanned.Publish(scanned);
+}
+
+void RAM_FUNC(ContinuousScanInput::UpdateInputs)(InputState &inputs) {
+    if (!_scanning) {
+        _source->UpdateInputs(inputs);
+        if (_scan_requested) {
+            memory_barrier();
+            _scanning = true;
+        }
+        return;
+    }
+
+    // Until the first continuous scan is in, the buttons stay as they were last scanned here.
+    const ScannedButtons scanned = _scanned.Read();
+    if (!scanned.scanned) {
+        return;
+    }
+    inputs.buttons = (inputs.buttons & ~_button_mask) | scanned.buttons;
+    // Where more than one source keeps track, the buttons last changed with the latest change.
+    if (!inputs.change_timed || (int32_t)(scanned.changed_us - inputs.changed_us) > 0) {
+        inputs.changed_us = scanned.changed_us;
+    }
+    inputs.change_timed = true;
+}
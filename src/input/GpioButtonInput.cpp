@@ -5,21 +5,50 @@
 GpioButtonInput::GpioButtonInput(GpioButtonMapping *button_mappings, size_t button_count) {
     _button_mappings = button_mappings;
     _button_count = button_count;
+    _button_mask = 0;
+
+    _scan_steps = new GpioScanStep[_button_count];
 
-    // Initialize button pins.
     for (size_t i = 0; i < _button_count; i++) {
         uint pin = _button_mappings[i].pin;
+
+        // Initialize button pin.
         gpio::init_pin(pin, gpio::GpioMode::GPIO_INPUT_PULLUP);
+        _button_mask |= input_mask(_button_mappings[i].button);
+
+        _scan_steps[i] = {
+            .port = (uint8_t)gpio::pin_port(pin),
+            .pin_mask = gpio::pin_mask(pin),
+            .button_mask = input_mask(_button_mappings[i].button),
+        };
     }
 }
 
+GpioButtonInput::~GpioButtonInput() {
+    delete[] _scan_steps;
+}
+
 InputScanSpeed GpioButtonInput::ScanSpeed() {
     return InputScanSpeed::FAST;
 }
 
-void GpioButtonInput::UpdateInputs(InputState &inputs) {
+uint32_t GpioButtonInput::ButtonMask() {
+    return _button_mask;
+}
+
+void RAM_FUNC(GpioButtonInput::UpdateInputs)(InputState &inputs) {
+    // Capture all ports up front so that every button is sampled at (almost) the same instant.
+    uint32_t port_levels[gpio::port_count];
+    gpio::read_all_ports(port_levels);
+
+    // Buttons are active low.
+    uint32_t pressed = 0;
     for (size_t i = 0; i < _button_count; i++) {
-        GpioButtonMapping button_mapping = _button_mappings[i];
-        inputs.*(button_mapping.button) = !gpio::read_digital(button_mapping.pin);
+        const GpioScanStep &step = _scan_steps[i];
+        if (!(port_levels[step.port] & step.pin_mask)) {
+            pressed |= step.button_mask;
+        }
     }
+    // Only touch the buttons we are responsible for so other input sources aren't clobbered.
+    inputs.buttons = (inputs.buttons & ~_button_mask) | pressed;
 }
@@ -6,13 +6,13 @@
 
 Melee18Button::Melee18Button(socd::SocdType socd_type, Melee18ButtonOptions options) {
     socd_type = MELEE_SOCD;
-    _socd_pair_count = 4;
-    _socd_pairs = new socd::SocdPair[_socd_pair_count]{
-        socd::SocdPair{&InputState::left,    &InputState::right,   socd_type},
-        socd::SocdPair{ &InputState::down,   &InputState::up,      socd_type},
-        socd::SocdPair{ &InputState::c_left, &InputState::c_right, socd_type},
-        socd::SocdPair{ &InputState::c_down, &InputState::c_up,    socd_type},
+    const socd::SocdPair socd_pairs[] = {
+        socd::SocdPair{InputBit::left,    InputBit::right,   socd_type},
+        socd::SocdPair{ InputBit::down,   InputBit::up,      socd_type},
+        socd::SocdPair{ InputBit::c_left, InputBit::c_right, socd_type},
+        socd::SocdPair{ InputBit::c_down, InputBit::c_up,    socd_type},
     };
+    SetSocdPairs(socd_pairs);
 
     _options = options;
     _horizontal_socd = false;
@@ -20,12 +20,12 @@ Melee18Button::Melee18Button(socd::SocdType socd_type, Melee18ButtonOptions opti
 
 bool Melee18Button::isMelee() {return true;}
 
-void Melee18Button::HandleSocd(InputState &inputs) {
+void RAM_FUNC(Melee18Button::HandleSocd)(InputState &inputs) {
     _horizontal_socd = inputs.left && inputs.right;
     InputMode::HandleSocd(inputs);
 }
 
-void Melee18Button::UpdateDigitalOutputs(InputState &inputs, OutputState &outputs) {
+void RAM_FUNC(Melee18Button::UpdateDigitalOutputs)(InputState &inputs, OutputState &outputs) {
     outputs.a = inputs.a;
     outputs.b = inputs.b;
     outputs.x = inputs.x;
@@ -49,7 +49,7 @@ void Melee18Button::UpdateDigitalOutputs(InputState &inputs, OutputState &output
         outputs.dpadRight = true;
 }
 
-void Melee18Button::UpdateAnalogOutputs(InputState &inputs, OutputState &outputs) {
+void RAM_FUNC(Melee18Button::UpdateAnalogOutputs)(InputState &inputs, OutputState &outputs) {
     // Coordinate calculations to make modifier handling simpler.
     UpdateDirections(
         inputs.left,
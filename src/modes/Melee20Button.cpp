@@ -6,15 +6,392 @@
 #define ANALOG_STICK_NEUTRAL 128
 #define ANALOG_STICK_MAX 208
 
+// Actual cardinal coordinates used by this mode.
+#define STICK_MIN (ANALOG_STICK_NEUTRAL - 112)
+#define STICK_MAX (ANALOG_STICK_NEUTRAL + 112)
+
+// On targets with flash to spare, the stick coordinates for every input combination are
+// precomputed into a table indexed by the packed input bits, so evaluating them is a single load.
+// AVR keeps .rodata in RAM, so it evaluates stick_coords() directly instead.
+#ifndef __AVR__
+#define MELEE20BUTTON_LUT
+#endif
+
+namespace {
+    // The digital inputs (and options) that the stick coordinates depend on.
+    typedef struct {
+        bool left;
+        bool right;
+        bool down;
+        bool up;
+        bool c_left;
+        bool c_right;
+        bool c_down;
+        bool c_up;
+        bool mod_x;
+        bool mod_y;
+        bool b;
+        bool l;
+        bool r;
+        bool lightshield;
+        bool midshield;
+        bool crouch_walk_os;
+    } StickInputs;
+
+    typedef struct {
+        uint8_t leftStickX;
+        uint8_t leftStickY;
+        uint8_t rightStickX;
+        uint8_t rightStickY;
+    } StickCoords;
+
+    constexpr StickCoords stick_coords(const StickInputs &inputs) {
+        // Coordinate calculations to make modifier handling simpler. Same as
+        // ControllerMode::UpdateDirections().
+        StickCoords outputs = {
+            ANALOG_STICK_NEUTRAL,
+            ANALOG_STICK_NEUTRAL,
+            ANALOG_STICK_NEUTRAL,
+            ANALOG_STICK_NEUTRAL,
+        };
+        StickDirections directions = {};
+        if (inputs.left || inputs.right) {
+            directions.horizontal = true;
+            directions.x = inputs.left ? -1 : 1;
+            outputs.leftStickX = inputs.left ? STICK_MIN : STICK_MAX;
+        }
+        if (inputs.down || inputs.up) {
+            directions.vertical = true;
+            directions.y = inputs.down ? -1 : 1;
+            outputs.leftStickY = inputs.down ? STICK_MIN : STICK_MAX;
+        }
+        directions.diagonal = directions.horizontal && directions.vertical;
+        if (inputs.c_left || inputs.c_right) {
+            directions.cx = inputs.c_left ? -1 : 1;
+            outputs.rightStickX = inputs.c_left ? STICK_MIN : STICK_MAX;
+        }
+        if (inputs.c_down || inputs.c_up) {
+            directions.cy = inputs.c_down ? -1 : 1;
+            outputs.rightStickY = inputs.c_down ? STICK_MIN : STICK_MAX;
+        }
+
+        bool shield_button_pressed = inputs.l || inputs.r || inputs.lightshield || inputs.midshield;
+        if (directions.diagonal) {
+            // q1/2 = 7000 7000
+            // actually 6875 7125 to account for randomness
+            outputs.leftStickX = 128 + (directions.x * 56);
+            outputs.leftStickY = 128 + (directions.y * 61);
+            // L, R, LS, and MS + q3/4 = 7125 6875 (For vanilla shield drop. Gives 44.5
+            // degree wavedash). Also used as default q3/4 diagonal if crouch walk option select is
+            // enabled.
+            // actually 7250 6750 to account for randomness
+            if (directions.y == -1 && inputs.crouch_walk_os) {
+                outputs.leftStickX = 128 + (directions.x * 61);
+                outputs.leftStickY = 128 + (directions.y * 56);
+            }
+        }
+
+        if (inputs.mod_x) {
+            // MX + Horizontal (even if shield is held) = 6625 = 53
+            if (directions.horizontal) {
+                outputs.leftStickX = 128 + (directions.x * 53);
+            }
+            // MX + Vertical (even if shield is held) = 5375 = 43
+            // y=-0.5500 (44) is solo nana ice block, so we reduce this by one
+            // MX + Vertical (even if shield is held) = 5250 = 42
+            if (directions.vertical) {
+                outputs.leftStickY = 128 + (directions.y * 42);
+            }
+            if (directions.diagonal && shield_button_pressed) {
+                if (!inputs.b) {
+                    // MX + L, R, LS, and MS + q1/2/3/4:
+                    // 6375 3750 - 30.47 deg - 51 30
+                    outputs.leftStickX = 128 + (directions.x * 51);
+                    outputs.leftStickY = 128 + (directions.y * 30);
+                } else {
+                    // Extended angle to have magnitude similarity for DI
+                    // 8500 5125 - 31.09 deg - 68 41
+                    outputs.leftStickX = 128 + (directions.x * 68);
+                    outputs.leftStickY = 128 + (directions.y * 41);
+                }
+            }
+
+            /* Up B angles */
+            if (directions.diagonal && !shield_button_pressed) {
+                if (!inputs.b) {
+                    // 7250 3125 - 23.32deg - 58 25 - modX
+                    // 7000 3625 - 27.38deg - 56 29 - modX + cDown
+                    // 6625 4125 - 31.91deg - 53 33 - modX + cLeft
+                    // 6375 4625 - 35.96deg - 51 37 - modX + cUp
+                    // 6125 5125 - 39.92deg - 49 41 - modX + cRight
+                    outputs.leftStickX = 128 + (directions.x * 58);
+                    outputs.leftStickY = 128 + (directions.y * 25);
+                    if (inputs.c_down) {
+                        outputs.leftStickX = 128 + (directions.x * 56);
+                        outputs.leftStickY = 128 + (directions.y * 29);
+                    }
+                    if (inputs.c_left) {
+                        outputs.leftStickX = 128 + (directions.x * 53);
+                        outputs.leftStickY = 128 + (directions.y * 33);
+                    }
+                    if (inputs.c_up) {
+                        outputs.leftStickX = 128 + (directions.x * 51);
+                        outputs.leftStickY = 128 + (directions.y * 37);
+                    }
+                    if (inputs.c_right) {
+                        outputs.leftStickX = 128 + (directions.x * 49);
+                        outputs.leftStickY = 128 + (directions.y * 41);
+                    }
+                } else {
+                    /* Extended Up B Angles */
+                    // 9125 3875 - 23.01deg - 73 31 - modX + B
+                    // 8750 4500 - 27.22deg - 70 36 - modX + B + cDown
+                    // 8500 5250 - 31.70deg - 68 42 - modX + B + cLeft
+                    // 7250 5250 - 35.91deg - 58 42 - modX + B + cUp
+                    // 6375 5250 - 39.47deg - 51 42 - modX + B + cRight
+                    outputs.leftStickX = 128 + (directions.x * 73);
+                    outputs.leftStickY = 128 + (directions.y * 31);
+                    if (inputs.c_down) {
+                        outputs.leftStickX = 128 + (directions.x * 70);
+                        outputs.leftStickY = 128 + (directions.y * 36);
+                    }
+                    if (inputs.c_left) {
+                        outputs.leftStickX = 128 + (directions.x * 68);
+                        outputs.leftStickY = 128 + (directions.y * 42);
+                    }
+                    if (inputs.c_up) {
+                        outputs.leftStickX = 128 + (directions.x * 58);
+                        outputs.leftStickY = 128 + (directions.y * 42);
+                    }
+                    if (inputs.c_right) {
+                        outputs.leftStickX = 128 + (directions.x * 51);
+                        outputs.leftStickY = 128 + (directions.y * 42);
+                    }
+                }
+            }
+
+            // Angled fsmash
+            if (directions.cx != 0 && directions.y != 0) {
+                // 8500 5250 = 68 42
+                outputs.rightStickX = 128 + (directions.cx * 68);
+                outputs.rightStickY = 128 + (directions.y * 42);
+            }
+        }
+
+        if (inputs.mod_y) {
+            // MY + Horizontal (even if shield is held) = 3375 = 27
+            if (directions.horizontal) {
+                outputs.leftStickX = 128 + (directions.x * 27);
+            }
+            // Turnaround neutral B nerf
+            if (inputs.b) {
+                outputs.leftStickX = 128 + (directions.x * 80);
+            }
+            // MY + Vertical (even if shield is held) = 7375 = 59
+            if (directions.vertical) {
+                outputs.leftStickY = 128 + (directions.y * 59);
+            }
+            if (directions.diagonal && shield_button_pressed) {
+                // MY + L, R, LS, and MS + q1/2 = 4750 8750 = 38 70
+                outputs.leftStickX = 128 + (directions.x * 38);
+                outputs.leftStickY = 128 + (directions.y * 70);
+                // MY + L, R, LS, and MS + q3/4 = 5000 8500 = 40 68
+                if (directions.y == -1) {
+                    outputs.leftStickX = 128 + (directions.x * 40);
+                    outputs.leftStickY = 128 + (directions.y * 68);
+                }
+            }
+
+            /* Up B angles */
+            if (directions.diagonal && !shield_button_pressed) {
+                if (!inputs.b) {
+                    // 3250 7625 - 23.09deg - 26 61 - modY
+                    // 3625 7000 - 27.38deg - 29 56 - modY + cDown
+                    // 4375 7000 - 32.01deg - 35 56 - modY + cLeft
+                    // 5125 7000 - 36.21deg - 41 56 - modY + cUp
+                    // 5750 7125 - 38.90deg - 46 57 - modY + cRight
+                    outputs.leftStickX = 128 + (directions.x * 26);
+                    outputs.leftStickY = 128 + (directions.y * 61);
+                    if (inputs.c_down) {
+                        outputs.leftStickX = 128 + (directions.x * 29);
+                        outputs.leftStickY = 128 + (directions.y * 56);
+                    }
+                    if (inputs.c_left) {
+                        outputs.leftStickX = 128 + (directions.x * 35);
+                        outputs.leftStickY = 128 + (directions.y * 56);
+                    }
+                    if (inputs.c_up) {
+                        outputs.leftStickX = 128 + (directions.x * 41);
+                        outputs.leftStickY = 128 + (directions.y * 56);
+                    }
+                    if (inputs.c_right) {
+                        outputs.leftStickX = 128 + (directions.x * 46);
+                        outputs.leftStickY = 128 + (directions.y * 57);
+                    }
+                } else {
+                    /* Extended Up B Angles */
+                    // 3875 9125 - 23.01deg - 31 73 - modY + B
+                    // 4625 8750 - 27.86deg - 37 70 - modY + B + cDown
+                    // 5250 8500 - 31.70deg - 42 68 - modY + B + cLeft
+                    // 5750 7875 - 36.14deg - 46 63 - modY + B + cUp
+                    // 5750 7125 - 38.90deg - 46 57 - modY + B + cRight
+                    outputs.leftStickX = 128 + (directions.x * 31);
+                    outputs.leftStickY = 128 + (directions.y * 73);
+                    if (inputs.c_down) {
+                        outputs.leftStickX = 128 + (directions.x * 37);
+                        outputs.leftStickY = 128 + (directions.y * 70);
+                    }
+                    if (inputs.c_left) {
+                        outputs.leftStickX = 128 + (directions.x * 42);
+                        outputs.leftStickY = 128 + (directions.y * 68);
+                    }
+                    if (inputs.c_up) {
+                        outputs.leftStickX = 128 + (directions.x * 46);
+                        outputs.leftStickY = 128 + (directions.y * 63);
+                    }
+                    if (inputs.c_right) {
+                        outputs.leftStickX = 128 + (directions.x * 46);
+                        outputs.leftStickY = 128 + (directions.y * 57);
+                    }
+                }
+            }
+        }
+
+        // C-stick ASDI Slideoff angle overrides any other C-stick modifiers (such as
+        // angled fsmash).
+        if (directions.cx != 0 && directions.cy != 0) {
+            // 5250 8500 = 42 68
+            outputs.rightStickX = 128 + (directions.cx * 42);
+            outputs.rightStickY = 128 + (directions.cy * 68);
+        }
+
+        return outputs;
+    }
+
+    // Bits of the lookup key. The lowest 8 match the layout of InputState::buttons.
+    constexpr uint8_t key_mod_x = 8;
+    constexpr uint8_t key_mod_y = 9;
+    constexpr uint8_t key_b = 10;
+    constexpr uint8_t key_shield = 11;
+    constexpr uint8_t key_crouch_walk_os = 12;
+    constexpr size_t key_count = 1 << 13;
+
+    constexpr uint16_t stick_key(uint32_t buttons, bool crouch_walk_os) {
+        constexpr uint32_t directions_mask =
+            input_mask(InputBit::left) | input_mask(InputBit::right) | input_mask(InputBit::down) |
+            input_mask(InputBit::up) | input_mask(InputBit::c_left) | input_mask(InputBit::c_right) |
+            input_mask(InputBit::c_down) | input_mask(InputBit::c_up);
+        constexpr uint32_t shield_mask = input_mask(InputBit::l) | input_mask(InputBit::r) |
+                                         input_mask(InputBit::lightshield) |
+                                         input_mask(InputBit::midshield);
+        static_assert(directions_mask == 0xFF, "Direction inputs must be the lowest 8 bits");
+
+        return (buttons & directions_mask) |
+               (bool(buttons & input_mask(InputBit::mod_x)) << key_mod_x) |
+               (bool(buttons & input_mask(InputBit::mod_y)) << key_mod_y) |
+               (bool(buttons & input_mask(InputBit::b)) << key_b) |
+               (bool(buttons & shield_mask) << key_shield) | (crouch_walk_os << key_crouch_walk_os);
+    }
+
+    constexpr StickInputs stick_inputs(uint32_t buttons, bool crouch_walk_os) {
+        return {
+            .left = bool(buttons & input_mask(InputBit::left)),
+            .right = bool(buttons & input_mask(InputBit::right)),
+            .down = bool(buttons & input_mask(InputBit::down)),
+            .up = bool(buttons & input_mask(InputBit::up)),
+            .c_left = bool(buttons & input_mask(InputBit::c_left)),
+            .c_right = bool(buttons & input_mask(InputBit::c_right)),
+            .c_down = bool(buttons & input_mask(InputBit::c_down)),
+            .c_up = bool(buttons & input_mask(InputBit::c_up)),
+            .mod_x = bool(buttons & input_mask(InputBit::mod_x)),
+            .mod_y = bool(buttons & input_mask(InputBit::mod_y)),
+            .b = bool(buttons & input_mask(InputBit::b)),
+            .l = bool(buttons & input_mask(InputBit::l)),
+            .r = bool(buttons & input_mask(InputBit::r)),
+            .lightshield = bool(buttons & input_mask(InputBit::lightshield)),
+            .midshield = bool(buttons & input_mask(InputBit::midshield)),
+            .crouch_walk_os = crouch_walk_os,
+        };
+    }
+
+#ifdef MELEE20BUTTON_LUT
+    typedef struct {
+        StickCoords coords[key_count];
+    } StickCoordsTable;
+
+    constexpr StickCoordsTable build_stick_coords_table() {
+        StickCoordsTable table = {};
+        for (size_t key = 0; key < key_count; key++) {
+            // Any one shield button stands in for all of them.
+            table.coords[key] = stick_coords({
+                .left = bool(key & (1 << (uint8_t)InputBit::left)),
+                .right = bool(key & (1 << (uint8_t)InputBit::right)),
+                .down = bool(key & (1 << (uint8_t)InputBit::down)),
+                .up = bool(key & (1 << (uint8_t)InputBit::up)),
+                .c_left = bool(key & (1 << (uint8_t)InputBit::c_left)),
+                .c_right = bool(key & (1 << (uint8_t)InputBit::c_right)),
+                .c_down = bool(key & (1 << (uint8_t)InputBit::c_down)),
+                .c_up = bool(key & (1 << (uint8_t)InputBit::c_up)),
+                .mod_x = bool(key & (1 << key_mod_x)),
+                .mod_y = bool(key & (1 << key_mod_y)),
+                .b = bool(key & (1 << key_b)),
+                .l = bool(key & (1 << key_shield)),
+                .r = false,
+                .lightshield = false,
+                .midshield = false,
+                .crouch_walk_os = bool(key & (1 << key_crouch_walk_os)),
+            });
+        }
+        return table;
+    }
+
+    // At 8192 entries the table stays in flash rather than taking up 32KB of SRAM. Each sample
+    // reads a single entry, so it costs at most one cache miss.
+    constexpr StickCoordsTable stick_coords_table = build_stick_coords_table();
+
+    // Verification: for every combination of the inputs that stick_coords() reads, looking up the
+    // packed key must give exactly what the branching implementation computes. This needs more
+    // constant evaluation steps than GCC allows by default, see -fconstexpr-ops-limit in
+    // platformio.ini.
+    constexpr bool verify_stick_coords_table() {
+        constexpr uint32_t relevant_mask =
+            0xFF | input_mask(InputBit::mod_x) | input_mask(InputBit::mod_y) |
+            input_mask(InputBit::b) | input_mask(InputBit::l) | input_mask(InputBit::r) |
+            input_mask(InputBit::lightshield) | input_mask(InputBit::midshield);
+        for (int crouch_walk_os = 0; crouch_walk_os < 2; crouch_walk_os++) {
+            // Enumerate every subset of relevant_mask.
+            uint32_t buttons = 0;
+            do {
+                StickCoords expected = stick_coords(stick_inputs(buttons, crouch_walk_os));
+                StickCoords actual = stick_coords_table.coords[stick_key(buttons, crouch_walk_os)];
+                if (expected.leftStickX != actual.leftStickX ||
+                    expected.leftStickY != actual.leftStickY ||
+                    expected.rightStickX != actual.rightStickX ||
+                    expected.rightStickY != actual.rightStickY) {
+                    return false;
+                }
+                buttons = (buttons - relevant_mask) & relevant_mask;
+            } while (buttons != 0);
+        }
+        return true;
+    }
+
+    static_assert(
+        verify_stick_coords_table(),
+        "Melee20Button stick coordinate table doesn't match stick_coords()"
+    );
+#endif
+}
+
 Melee20Button::Melee20Button(socd::SocdType socd_type, Melee20ButtonOptions options) {
     socd_type = MELEE_SOCD;
-    _socd_pair_count = 4;
-    _socd_pairs = new socd::SocdPair[_socd_pair_count]{
-        socd::SocdPair{&InputState::left,    &InputState::right,   socd_type},
-        socd::SocdPair{ &InputState::down,   &InputState::up,      socd_type},
-        socd::SocdPair{ &InputState::c_left, &InputState::c_right, socd_type},
-        socd::SocdPair{ &InputState::c_down, &InputState::c_up,    socd_type},
+    const socd::SocdPair socd_pairs[] = {
+        socd::SocdPair{InputBit::left,    InputBit::right,   socd_type},
+        socd::SocdPair{ InputBit::down,   InputBit::up,      socd_type},
+        socd::SocdPair{ InputBit::c_left, InputBit::c_right, socd_type},
+        socd::SocdPair{ InputBit::c_down, InputBit::c_up,    socd_type},
     };
+    SetSocdPairs(socd_pairs);
 
     _options = options;
     _horizontal_socd = false;
@@ -22,12 +399,12 @@ Melee20Button::Melee20Button(socd::SocdType socd_type, Melee20ButtonOptions opti
 
 bool Melee20Button::isMelee() {return true;}
 
-void Melee20Button::HandleSocd(InputState &inputs) {
+void RAM_FUNC(Melee20Button::HandleSocd)(InputState &inputs) {
     _horizontal_socd = inputs.left && inputs.right;
     InputMode::HandleSocd(inputs);
 }
 
-void Melee20Button::UpdateDigitalOutputs(InputState &inputs, OutputState &outputs) {
+void RAM_FUNC(Melee20Button::UpdateDigitalOutputs)(InputState &inputs, OutputState &outputs) {
     outputs.a = inputs.a;
     outputs.b = inputs.b;
     outputs.x = inputs.x;
@@ -51,212 +428,16 @@ void Melee20Button::UpdateDigitalOutputs(InputState &inputs, OutputState &output
         outputs.dpadRight = true;
 }
 
-void Melee20Button::UpdateAnalogOutputs(InputState &inputs, OutputState &outputs) {
-    // Coordinate calculations to make modifier handling simpler.
-    UpdateDirections(
-        inputs.left,
-        inputs.right,
-        inputs.down,
-        inputs.up,
-        inputs.c_left,
-        inputs.c_right,
-        inputs.c_down,
-        inputs.c_up,
-        /*ANALOG_STICK_MIN*/ANALOG_STICK_NEUTRAL - 112,
-        ANALOG_STICK_NEUTRAL,
-        /*ANALOG_STICK_MAX*/ANALOG_STICK_NEUTRAL + 112,
-        outputs
-    );
-
-    bool shield_button_pressed = inputs.l || inputs.r || inputs.lightshield || inputs.midshield;
-    if (directions.diagonal) {
-        // q1/2 = 7000 7000
-        // actually 6875 7125 to account for randomness
-        outputs.leftStickX = 128 + (directions.x * 56);
-        outputs.leftStickY = 128 + (directions.y * 61);
-        // L, R, LS, and MS + q3/4 = 7125 6875 (For vanilla shield drop. Gives 44.5
-        // degree wavedash). Also used as default q3/4 diagonal if crouch walk option select is
-        // enabled.
-        // actually 7250 6750 to account for randomness
-        if (directions.y == -1 && _options.crouch_walk_os) {
-            outputs.leftStickX = 128 + (directions.x * 61);
-            outputs.leftStickY = 128 + (directions.y * 56);
-        }
-    }
-
-    if (inputs.mod_x) {
-        // MX + Horizontal (even if shield is held) = 6625 = 53
-        if (directions.horizontal) {
-            outputs.leftStickX = 128 + (directions.x * 53);
-        }
-        // MX + Vertical (even if shield is held) = 5375 = 43
-        // y=-0.5500 (44) is solo nana ice block, so we reduce this by one
-        // MX + Vertical (even if shield is held) = 5250 = 42
-        if (directions.vertical) {
-            outputs.leftStickY = 128 + (directions.y * 42);
-        }
-        if (directions.diagonal && shield_button_pressed) {
-            if (!inputs.b) {
-                // MX + L, R, LS, and MS + q1/2/3/4:
-                // 6375 3750 - 30.47 deg - 51 30
-                outputs.leftStickX = 128 + (directions.x * 51);
-                outputs.leftStickY = 128 + (directions.y * 30);
-            } else {
-                // Extended angle to have magnitude similarity for DI
-                // 8500 5125 - 31.09 deg - 68 41
-                outputs.leftStickX = 128 + (directions.x * 68);
-                outputs.leftStickY = 128 + (directions.y * 41);
-            }
-        }
-
-        /* Up B angles */
-        if (directions.diagonal && !shield_button_pressed) {
-            if (!inputs.b) {
-                // 7250 3125 - 23.32deg - 58 25 - modX
-                // 7000 3625 - 27.38deg - 56 29 - modX + cDown
-                // 6625 4125 - 31.91deg - 53 33 - modX + cLeft
-                // 6375 4625 - 35.96deg - 51 37 - modX + cUp
-                // 6125 5125 - 39.92deg - 49 41 - modX + cRight
-                outputs.leftStickX = 128 + (directions.x * 58);
-                outputs.leftStickY = 128 + (directions.y * 25);
-                if (inputs.c_down) {
-                    outputs.leftStickX = 128 + (directions.x * 56);
-                    outputs.leftStickY = 128 + (directions.y * 29);
-                }
-                if (inputs.c_left) {
-                    outputs.leftStickX = 128 + (directions.x * 53);
-                    outputs.leftStickY = 128 + (directions.y * 33);
-                }
-                if (inputs.c_up) {
-                    outputs.leftStickX = 128 + (directions.x * 51);
-                    outputs.leftStickY = 128 + (directions.y * 37);
-                }
-                if (inputs.c_right) {
-                    outputs.leftStickX = 128 + (directions.x * 49);
-                    outputs.leftStickY = 128 + (directions.y * 41);
-                }
-            } else {
-                /* Extended Up B Angles */
-                // 9125 3875 - 23.01deg - 73 31 - modX + B
-                // 8750 4500 - 27.22deg - 70 36 - modX + B + cDown
-                // 8500 5250 - 31.70deg - 68 42 - modX + B + cLeft
-                // 7250 5250 - 35.91deg - 58 42 - modX + B + cUp
-                // 6375 5250 - 39.47deg - 51 42 - modX + B + cRight
-                outputs.leftStickX = 128 + (directions.x * 73);
-                outputs.leftStickY = 128 + (directions.y * 31);
-                if (inputs.c_down) {
-                    outputs.leftStickX = 128 + (directions.x * 70);
-                    outputs.leftStickY = 128 + (directions.y * 36);
-                }
-                if (inputs.c_left) {
-                    outputs.leftStickX = 128 + (directions.x * 68);
-                    outputs.leftStickY = 128 + (directions.y * 42);
-                }
-                if (inputs.c_up) {
-                    outputs.leftStickX = 128 + (directions.x * 58);
-                    outputs.leftStickY = 128 + (directions.y * 42);
-                }
-                if (inputs.c_right) {
-                    outputs.leftStickX = 128 + (directions.x * 51);
-                    outputs.leftStickY = 128 + (directions.y * 42);
-                }
-            }
-        }
-
-        // Angled fsmash
-        if (directions.cx != 0 && directions.y != 0) {
-            // 8500 5250 = 68 42
-            outputs.rightStickX = 128 + (directions.cx * 68);
-            outputs.rightStickY = 128 + (directions.y * 42);
-        }
-    }
-
-    if (inputs.mod_y) {
-        // MY + Horizontal (even if shield is held) = 3375 = 27
-        if (directions.horizontal) {
-            outputs.leftStickX = 128 + (directions.x * 27);
-        }
-        // Turnaround neutral B nerf
-        if (inputs.b) {
-            outputs.leftStickX = 128 + (directions.x * 80);
-        }
-        // MY + Vertical (even if shield is held) = 7375 = 59
-        if (directions.vertical) {
-            outputs.leftStickY = 128 + (directions.y * 59);
-        }
-        if (directions.diagonal && shield_button_pressed) {
-            // MY + L, R, LS, and MS + q1/2 = 4750 8750 = 38 70
-            outputs.leftStickX = 128 + (directions.x * 38);
-            outputs.leftStickY = 128 + (directions.y * 70);
-            // MY + L, R, LS, and MS + q3/4 = 5000 8500 = 40 68
-            if (directions.y == -1) {
-                outputs.leftStickX = 128 + (directions.x * 40);
-                outputs.leftStickY = 128 + (directions.y * 68);
-            }
-        }
-
-        /* Up B angles */
-        if (directions.diagonal && !shield_button_pressed) {
-            if (!inputs.b) {
-                // 3250 7625 - 23.09deg - 26 61 - modY
-                // 3625 7000 - 27.38deg - 29 56 - modY + cDown
-                // 4375 7000 - 32.01deg - 35 56 - modY + cLeft
-                // 5125 7000 - 36.21deg - 41 56 - modY + cUp
-                // 5750 7125 - 38.90deg - 46 57 - modY + cRight
-                outputs.leftStickX = 128 + (directions.x * 26);
-                outputs.leftStickY = 128 + (directions.y * 61);
-                if (inputs.c_down) {
-                    outputs.leftStickX = 128 + (directions.x * 29);
-                    outputs.leftStickY = 128 + (directions.y * 56);
-                }
-                if (inputs.c_left) {
-                    outputs.leftStickX = 128 + (directions.x * 35);
-                    outputs.leftStickY = 128 + (directions.y * 56);
-                }
-                if (inputs.c_up) {
-                    outputs.leftStickX = 128 + (directions.x * 41);
-                    outputs.leftStickY = 128 + (directions.y * 56);
-                }
-                if (inputs.c_right) {
-                    outputs.leftStickX = 128 + (directions.x * 46);
-                    outputs.leftStickY = 128 + (directions.y * 57);
-                }
-            } else {
-                /* Extended Up B Angles */
-                // 3875 9125 - 23.01deg - 31 73 - modY + B
-                // 4625 8750 - 27.86deg - 37 70 - modY + B + cDown
-                // 5250 8500 - 31.70deg - 42 68 - modY + B + cLeft
-                // 5750 7875 - 36.14deg - 46 63 - modY + B + cUp
-                // 5750 7125 - 38.90deg - 46 57 - modY + B + cRight
-                outputs.leftStickX = 128 + (directions.x * 31);
-                outputs.leftStickY = 128 + (directions.y * 73);
-                if (inputs.c_down) {
-                    outputs.leftStickX = 128 + (directions.x * 37);
-                    outputs.leftStickY = 128 + (directions.y * 70);
-                }
-                if (inputs.c_left) {
-                    outputs.leftStickX = 128 + (directions.x * 42);
-                    outputs.leftStickY = 128 + (directions.y * 68);
-                }
-                if (inputs.c_up) {
-                    outputs.leftStickX = 128 + (directions.x * 46);
-                    outputs.leftStickY = 128 + (directions.y * 63);
-                }
-                if (inputs.c_right) {
-                    outputs.leftStickX = 128 + (directions.x * 46);
-                    outputs.leftStickY = 128 + (directions.y * 57);
-                }
-            }
-        }
-    }
-
-    // C-stick ASDI Slideoff angle overrides any other C-stick modifiers (such as
-    // angled fsmash).
-    if (directions.cx != 0 && directions.cy != 0) {
-        // 5250 8500 = 42 68
-        outputs.rightStickX = 128 + (directions.cx * 42);
-        outputs.rightStickY = 128 + (directions.cy * 68);
-    }
+void RAM_FUNC(Melee20Button::UpdateAnalogOutputs)(InputState &inputs, OutputState &outputs) {
+#ifdef MELEE20BUTTON_LUT
+    StickCoords coords = stick_coords_table.coords[stick_key(inputs.buttons, _options.crouch_walk_os)];
+#else
+    StickCoords coords = stick_coords(stick_inputs(inputs.buttons, _options.crouch_walk_os));
+#endif
+    outputs.leftStickX = coords.leftStickX;
+    outputs.leftStickY = coords.leftStickY;
+    outputs.rightStickX = coords.rightStickX;
+    outputs.rightStickY = coords.rightStickY;
 
     /*
     // Horizontal SOCD overrides X-axis modifiers (for ledgedash maximum jump
@@ -1,8 +1,6 @@
 #include "modes/MeleeLimits.hpp"
 //#include "modes/Fixed.h"
 
-#define HISTORYLEN 5//changes in target stick position
-
 #define ANALOG_STICK_MIN 48
 #define ANALOG_DEAD_MIN (128-22)/*this is in the deadzone*/
 #define ANALOG_STICK_NEUTRAL 128
@@ -28,33 +26,43 @@
 #define TRAVELTIME_INTERNAL 12//ms for "easy" to "internal"; 2/3 frame
 #define TRAVELTIME_SLOW 88//(5.5*16)//ms for tap SDI nerfing, 5.5 frames
 
-#define TIMELIMIT_DOWNUP (16*3*250)//units of 4us; how long after a crouch to upward input should it begin a jump?
-#define JUMP_TIME (16*2*250)//units of 4us; after a recent crouch to upward input, always hold full up for 2 frames
+#define TIMELIMIT_DOWNUP (16*3*1000)//us; how long after a crouch to upward input should it begin a jump?
+#define JUMP_TIME (16*2*1000)//us; after a recent crouch to upward input, always hold full up for 2 frames
+
+#define TIMELIMIT_FRAME 16667//us; 1 frame, for reference
+#define TIMELIMIT_HALFFRAME 8333//us; 1/2 frame
+#define TIMELIMIT_DEBOUNCE 6000//us; 6ms;
+#define TIMELIMIT_SIMUL 2000//us; 2ms: if the latest inputs are less than 2 ms apart then don't nerf cardiag
+
+#define TIMELIMIT_TAPSHUTOFF 64000//4 frames for tap jump shutoff
+
+//not used #define TIMELIMIT_DASH 240000//(16*15*1000)//us; last dash time prior to a pivot input; 15 frames
+
+//not used #define TIMELIMIT_QCIRC 96000//(16*6*1000)//us; 6 frames
 
-#define TIMELIMIT_FRAME 4167//(16.66...*250)//units of 4us; 1 frame, for reference
-#define TIMELIMIT_HALFFRAME 2083//(8.33...*250)//units of 4us; 1/2 frame
-#define TIMELIMIT_DEBOUNCE 1500//(6*250)//units of 4us; 6ms;
-#define TIMELIMIT_SIMUL 500//(2*250)//units of 4us; 2ms: if the latest inputs are less than 2 ms apart then don't nerf cardiag
+#define TIMELIMIT_TAP 88000//(16*5.5*1000)//us; 5.5 frames
+#define TIMELIMIT_TAP_PLUS 136000//(16*8.5*1000)//us; 3 additional frames
 
-#define TIMELIMIT_TAPSHUTOFF 16000//4 frames for tap jump shutoff
+#define TIMELIMIT_CARDIAG 128000//(16*8*1000)//us; 8 frames
 
-//not used #define TIMELIMIT_DASH 60000//(16*15*250)//units of 4us; last dash time prior to a pivot input; 15 frames
+#define TIMELIMIT_WANK 88000//(16*5.5*1000)//us; 5.5 frames
 
-//not used #define TIMELIMIT_QCIRC 24000//(16*6*250)//units of 4us; 6 frames
+#define TIMELIMIT_PIVOTTILT 128000//(16*8*1000)//us; 8 frames
 
-#define TIMELIMIT_TAP 22000//(16*5.5*250)//units of 4us; 5.5 frames
-#define TIMELIMIT_TAP_PLUS 34000//(16*8.5*250)//units of 4us; 3 additional frames
+#define TIMELIMIT_SDI_COUNTDOWN 64000//(16*4*1000)//us; 4 frames
 
-#define TIMELIMIT_CARDIAG 32000//(16*8*250)//units of 4us; 8 frames
+#define TIMELIMIT_SDI_STALE 256000//(16*16*1000)//us; 16 frames
 
-#define TIMELIMIT_WANK 22000//(16*5.5*250)//units of 4us; 5.5 frames
+#define TIMELIMIT_PIVOT_STALE 240000//(16*15*1000)//us; 15 frames
 
-#define TIMELIMIT_PIVOTTILT 32000//(16*8*250)//units of 4us; 8 frames
+#define TIMELIMIT_HISTORY 1000000//us; after a gap this long between samples, all history is stale
 
-#define TIMELIMIT_SDI_COUNTDOWN 16000//(16*4*250)//units of 4us; 4 frames
+//timers that count up by themselves while the inputs stay the same
+#define COUNTING_NOTUPTILT 0b001
+#define COUNTING_CROUCH    0b010
+#define COUNTING_JUMP      0b100
 
 enum pivotdir{P_None, P_Leftright, P_Rightleft};
-enum travelType{T_Lin, T_Quad, T_Cubic, T_Quart, T_Delay};
 
 #define ZONE_DIR 0b0000'1111
 #define ZONE_U   0b0000'0001
@@ -68,32 +76,17 @@ enum travelType{T_Lin, T_Quad, T_Cubic, T_Quart, T_Delay};
 #define BITS_SDI_TAP_DIAG 0b0100'0000
 #define BITS_SDI_TAP_CRDG 0b1000'0000
 
-typedef struct {
-    uint16_t timestamp;//in samples
-    uint8_t tt;//travel time used in ms
-    uint8_t x;
-    uint8_t y;
-    uint8_t x_start;
-    uint8_t y_start;
-    uint8_t x_end;
-    uint8_t y_end;
-} shortstate;
-
-//for sdi nerfs, we want to record only movement between sdi zones, ignoring movement within zones
-typedef struct {
-    uint16_t timestamp;//in samples
-    uint8_t zone;
-    bool stale;
-} sdizonestate;
-
-//for pivot nerfs, we want to record only movement between dash zones, ignoring movement within zones
-typedef struct {
-    uint16_t timestamp;//in samples
-    uint8_t zone;
-    bool stale;
-} pivotzonestate;
-
-uint8_t isEasy(const uint8_t x, const uint8_t y) {
+//inputs that can cause changes to coordinates, other than L and R
+#define COORD_INPUTS (input_mask(InputBit::left) | input_mask(InputBit::right) | \
+                      input_mask(InputBit::down) | input_mask(InputBit::up) | \
+                      input_mask(InputBit::c_left) | input_mask(InputBit::c_right) | \
+                      input_mask(InputBit::c_down) | input_mask(InputBit::c_up) | \
+                      input_mask(InputBit::b) | \
+                      input_mask(InputBit::lightshield) | input_mask(InputBit::midshield) | \
+                      input_mask(InputBit::mod_x) | input_mask(InputBit::mod_y))
+#define TRIGGER_INPUTS (input_mask(InputBit::l) | input_mask(InputBit::r))
+
+uint8_t RAM_FUNC(isEasy)(const uint8_t x, const uint8_t y) {
     //is it on the rim?
     const uint8_t xnorm = (x > ANALOG_STICK_NEUTRAL ? (x-ANALOG_STICK_NEUTRAL) : (ANALOG_STICK_NEUTRAL-x));
     const uint8_t ynorm = (y > ANALOG_STICK_NEUTRAL ? (y-ANALOG_STICK_NEUTRAL) : (ANALOG_STICK_NEUTRAL-y));
@@ -122,9 +115,13 @@ uint8_t isEasy(const uint8_t x, const uint8_t y) {
     }
 }
 
-uint8_t getRandom(uint16_t currentTime) {
+uint8_t RAM_FUNC(getRandom)(uint16_t currentTime, randomstate &state) {
     // Use the time of the first directional input to initialize the LCG
-    static uint16_t random = currentTime;
+    if(!state.seeded) {
+        state.value = currentTime;
+        state.seeded = true;
+    }
+    uint16_t &random = state.value;
     // Constant from https://arxiv.org/pdf/2001.05304.pdf
     random = 0xD9F5 * random + 1;
     // XOR all nibbles together, necessary to minimize patterns with a power of 2 LCG
@@ -136,8 +133,8 @@ uint8_t getRandom(uint16_t currentTime) {
 // 2 4 2 //8
 // 1 2 1 //4
 // totals up to 16
-void randomizeCoord(uint8_t &x, uint8_t &y, uint16_t currentTime) {
-    const uint8_t random = getRandom(currentTime);
+void RAM_FUNC(randomizeCoord)(uint8_t &x, uint8_t &y, uint16_t currentTime, randomstate &state) {
+    const uint8_t random = getRandom(currentTime, state);
     const uint8_t left = ((random ^ 0b0) & 0b11) == 0;
     //middle is when random & 0b01 or 0b10
     const uint8_t right = ((random ^ 0b11) & 0b11) == 0;
@@ -150,7 +147,15 @@ void randomizeCoord(uint8_t &x, uint8_t &y, uint16_t currentTime) {
     y = (y != ANALOG_STICK_NEUTRAL) ? y - down + up : y;
 }
 
-uint8_t lookback(const uint8_t currentIndex,
+//adds the time elapsed since the last sample to a timer, stopping at the limit
+uint32_t RAM_FUNC(advanceTimer)(const uint32_t timer,
+                      const uint32_t sampleSpacing,
+                      const uint32_t limit) {
+    const uint32_t advanced = timer + sampleSpacing;
+    return advanced < limit ? advanced : limit;
+}
+
+uint8_t RAM_FUNC(lookback)(const uint8_t currentIndex,
                  const uint8_t samplesBack) {
     if(samplesBack > currentIndex) {
         return (HISTORYLEN-samplesBack) + currentIndex;
@@ -166,7 +171,7 @@ uint8_t lookback(const uint8_t currentIndex,
 //0b0000'1000 for right
 //no bits set for neutral
 //thresholds are dash for cardinals, and deadzone for diagonals
-uint8_t sdiZone(const uint8_t x, const uint8_t y) {
+uint8_t RAM_FUNC(sdiZone)(const uint8_t x, const uint8_t y) {
     uint8_t result = 0b0000'0000;
     const uint8_t xnorm = (x > ANALOG_STICK_NEUTRAL ? (x-ANALOG_STICK_NEUTRAL) : (ANALOG_STICK_NEUTRAL-x));
     const uint8_t ynorm = (y > ANALOG_STICK_NEUTRAL ? (y-ANALOG_STICK_NEUTRAL) : (ANALOG_STICK_NEUTRAL-y));
@@ -204,7 +209,7 @@ uint8_t sdiZone(const uint8_t x, const uint8_t y) {
 //0b0000'1000 for right
 //no bits set for neutral
 //thresholds are dash for the x-axis
-uint8_t pivotZone(const uint8_t x) {
+uint8_t RAM_FUNC(pivotZone)(const uint8_t x) {
     uint8_t result = 0b0000'0000;
     if(x <= ANALOG_DASH_LEFT) {
         result = result | ZONE_L;
@@ -214,7 +219,7 @@ uint8_t pivotZone(const uint8_t x) {
     return result;
 }
 
-uint8_t uptiltShutoffZone(const uint8_t y) {
+uint8_t RAM_FUNC(uptiltShutoffZone)(const uint8_t y) {
     uint8_t result = 0b0000'0000;
     if(y > ANALOG_DEAD_MAX && y < ANALOG_TAPJUMP) {
         result = result | ZONE_U;
@@ -223,7 +228,7 @@ uint8_t uptiltShutoffZone(const uint8_t y) {
 }
 
 //not a general purpose popcount, this is specifically for zones
-uint8_t popcount_zone(const uint8_t bitsIn) {
+uint8_t RAM_FUNC(popcount_zone)(const uint8_t bitsIn) {
     uint8_t count = 0;
     for(uint8_t i = 0; i < 4; i++) {
         if((bitsIn >> i) & 0b0000'0001) {
@@ -233,16 +238,15 @@ uint8_t popcount_zone(const uint8_t bitsIn) {
     return count;
 }
 
-uint8_t isTapSDI(const sdizonestate zoneHistory[HISTORYLEN],
+uint8_t RAM_FUNC(isTapSDI)(const sdizonestate zoneHistory[HISTORYLEN],
                  const uint8_t currentIndex,
-                 const uint16_t currentTime,
-                 const uint16_t sampleSpacing) {
+                 const uint32_t currentTime) {
     uint8_t output = 0;
 
     //grab the last five zones
     const uint8_t historyLength = min(5, HISTORYLEN);
     uint8_t zoneList[historyLength];
-    uint16_t timeList[historyLength];
+    uint32_t timeList[historyLength];
     bool staleList[historyLength];
     for(int i = 0; i < historyLength; i++) {
         const uint8_t index = lookback(currentIndex, i);
@@ -257,9 +261,9 @@ uint8_t isTapSDI(const sdizonestate zoneHistory[HISTORYLEN],
     // if we're changing zones back and forth
     if(zoneList[0] != zoneList[1] && (zoneList[0] == zoneList[2]) && (zoneList[1] == zoneList[3])) {
         //check the time duration
-        const uint16_t timeDiff0 = (currentTime - timeList[2])*sampleSpacing;//make sure things aren't reliant on long-past inputs
-        const uint16_t timeDiff1 = (timeList[0] - timeList[2])*sampleSpacing;//rising edge to rising edge, or falling edge to falling edge
-        //const uint16_t timeDiff2 = (timeList[0] - timeList[1])*sampleSpacing;//rising to falling, or falling to rising
+        const uint32_t timeDiff0 = currentTime - timeList[2];//make sure things aren't reliant on long-past inputs
+        const uint32_t timeDiff1 = timeList[0] - timeList[2];//rising edge to rising edge, or falling edge to falling edge
+        //const uint32_t timeDiff2 = timeList[0] - timeList[1];//rising to falling, or falling to rising
         //We want to nerf it if there is more than one press every 6 frames, but not if the previous press or release duration is less than 1 frame
         if(!staleList[2] && (timeDiff0 < TIMELIMIT_TAP_PLUS && timeDiff1 < TIMELIMIT_TAP && timeDiff0 > TIMELIMIT_DEBOUNCE)) {
             if((zoneList[0] == 0) || (zoneList[1] == 0)) {//if one of the pairs of zones is zero, it's tapping a cardinal (or tapping a diagonal modifier)
@@ -299,8 +303,8 @@ uint8_t isTapSDI(const sdizonestate zoneHistory[HISTORYLEN],
         //check whether it returned to center recently
         //const bool recentOrig = (zoneList[1] & zoneList[2]) == 0;//may be too lenient in case people throw in modifier taps?
         //check whether the input was fast enough
-        const bool shortTime = ((timeList[0] - timeList[4])*sampleSpacing < TIMELIMIT_CARDIAG) &&
-                               ((timeList[0] - timeList[1])*sampleSpacing > TIMELIMIT_SIMUL) &&
+        const bool shortTime = ((timeList[0] - timeList[4]) < TIMELIMIT_CARDIAG) &&
+                               ((timeList[0] - timeList[1]) > TIMELIMIT_SIMUL) &&
                                !staleList[4];
 
         // if only the same diagonal was pressed
@@ -336,7 +340,7 @@ uint8_t isTapSDI(const sdizonestate zoneHistory[HISTORYLEN],
     {//to limit scope of these vars
         //check the bit count of diagonal matching
         const bool adjacentDiag = popcount_zone(diagZone & cardZone) == 1;
-        const bool shortTime = ((timeList[0] - timeList[3])*sampleSpacing < TIMELIMIT_WANK) &&
+        const bool shortTime = ((timeList[0] - timeList[3]) < TIMELIMIT_WANK) &&
                                !staleList[3];
         //if it hit two different diagonals
         //                 hit origin, at least one cardinal, and two diagonals
@@ -358,7 +362,7 @@ uint8_t isTapSDI(const sdizonestate zoneHistory[HISTORYLEN],
         //were there two of the same diagonal on alternating inputs?
         if((zoneList[0] == zoneList[2]) && (popcount_zone(zoneList[0]) == 2)) {
             //check duration
-            if((timeList[0] - timeList[2])*sampleSpacing < TIMELIMIT_WANK && !staleList[2]) {
+            if((timeList[0] - timeList[2]) < TIMELIMIT_WANK && !staleList[2]) {
                 output = output | BITS_SDI_WANK | BITS_SDI_TAP_CRDG;
             }
         }
@@ -396,9 +400,8 @@ Fixed88 quarticEasing(Fixed88 i){
 }
 */
 
-void travelTimeCalc(const uint16_t currentTime,
-                    const uint16_t inputTime,
-                    const uint16_t sampleSpacing,//units of 4us
+void RAM_FUNC(travelTimeCalc)(const uint32_t currentTime,
+                    const uint32_t inputTime,
                     const uint8_t msTravel,
                     const uint8_t startX,
                     const uint8_t startY,
@@ -408,9 +411,10 @@ void travelTimeCalc(const uint16_t currentTime,
                     bool &doneTraveling,//apply tt if false; when travel time is done, set it to true
                     uint8_t &outX,
                     uint8_t &outY) {
-    const uint16_t samplesElapsed = currentTime - inputTime;
+    //once the travel is over, how long ago it started doesn't matter, so stop counting just past it
+    const uint32_t usElapsed = min(currentTime - inputTime, (uint32_t)msTravel*1000 + 4);
 
-    const uint16_t timeElapsed = samplesElapsed*sampleSpacing;//units of 4 us
+    const uint16_t timeElapsed = usElapsed/4;//units of 4 us
     if(type == T_Lin) {
         const uint16_t travelTimeElapsed = timeElapsed/msTravel;//250 times the fraction of the travel time elapsed
 
@@ -476,11 +480,190 @@ void travelTimeCalc(const uint16_t currentTime,
     }
 }
 
-void limitOutputs(const uint16_t sampleSpacing,//in units of 4us
+//shortens the wait to when something's age reaches the limit, unless it already has
+void RAM_FUNC(waitForLimit)(uint32_t &wait, const uint32_t age, const uint32_t limit) {
+    if(age < limit && limit - age < wait) {
+        wait = limit - age;
+    }
+}
+
+//how long until any of the time limits could make unchanged inputs give a different result
+uint32_t RAM_FUNC(timeUntilChange)(const MeleeLimiterState &state, const uint32_t currentTime) {
+    //past this gap, the history is marked stale
+    uint32_t wait = TIMELIMIT_HISTORY+1;
+    for(int i = 0; i < HISTORYLEN; i++) {
+        if(!state.sdiZoneHist[i].stale) {
+            waitForLimit(wait, currentTime - state.sdiZoneHist[i].timestamp, TIMELIMIT_SDI_STALE+1);
+        }
+        if(!state.pivotZoneHist[i].stale) {
+            waitForLimit(wait, currentTime - state.pivotZoneHist[i].timestamp, TIMELIMIT_PIVOT_STALE+1);
+        }
+    }
+    //the tap SDI window in isTapSDI
+    const uint32_t tapAge = currentTime - state.sdiZoneHist[lookback(state.currentIndexSDI, 2)].timestamp;
+    waitForLimit(wait, tapAge, TIMELIMIT_DEBOUNCE+1);
+    waitForLimit(wait, tapAge, TIMELIMIT_TAP_PLUS);
+    waitForLimit(wait, currentTime - state.pivotZoneHist[0].timestamp, TIMELIMIT_PIVOTTILT+1);
+    //the timers that are counting up
+    if(state.quietCounting & COUNTING_NOTUPTILT) {
+        waitForLimit(wait, state.timeSinceNotUptilt, TIMELIMIT_TAPSHUTOFF+1);
+    }
+    if(state.quietCounting & COUNTING_CROUCH) {
+        waitForLimit(wait, state.timeSinceCrouch, TIMELIMIT_DOWNUP);
+    }
+    if(state.quietCounting & COUNTING_JUMP) {
+        waitForLimit(wait, state.timeSinceJump, JUMP_TIME);
+    }
+    return wait;
+}
+
+//the parts of the state that a full pass over unchanged inputs can change
+//history is only pushed, which moves an index or the newest pivot zone, edited in place at the current A index, or marked stale
+typedef struct {
+    uint32_t prevTime;
+    uint8_t prevX;
+    uint8_t prevY;
+    uint8_t currentIndexA;
+    uint8_t currentIndexSDI;
+    shortstate currentA;
+    uint32_t newestPivotTime;
+    uint16_t staleZones;//sdi zones in the low bits, pivot zones above them
+    travelType delayType;
+    bool doneTraveling;
+    bool wavedashWasNerfed;
+    bool sdiIsNerfed;
+    bool downUpJumping;
+    uint32_t sdiCountdown;
+    uint32_t timeSinceNotUptilt;
+    uint32_t timeSinceCrouch;
+    uint32_t timeSinceJump;
+    randomstate random;
+} changeablestate;
+
+void RAM_FUNC(saveChangeable)(const MeleeLimiterState &state, changeablestate &saved) {
+    saved.prevTime = state.prevTime;
+    saved.prevX = state.prevX;
+    saved.prevY = state.prevY;
+    saved.currentIndexA = state.currentIndexA;
+    saved.currentIndexSDI = state.currentIndexSDI;
+    saved.currentA = state.aHistory[state.currentIndexA];
+    saved.newestPivotTime = state.pivotZoneHist[0].timestamp;
+    saved.staleZones = 0;
+    for(int i = 0; i < HISTORYLEN; i++) {
+        saved.staleZones |= state.sdiZoneHist[i].stale << i;
+        saved.staleZones |= state.pivotZoneHist[i].stale << (i + HISTORYLEN);
+    }
+    saved.delayType = state.delayType;
+    saved.doneTraveling = state.doneTraveling;
+    saved.wavedashWasNerfed = state.wavedashWasNerfed;
+    saved.sdiIsNerfed = state.sdiIsNerfed;
+    saved.downUpJumping = state.downUpJumping;
+    saved.sdiCountdown = state.sdiCountdown;
+    saved.timeSinceNotUptilt = state.timeSinceNotUptilt;
+    saved.timeSinceCrouch = state.timeSinceCrouch;
+    saved.timeSinceJump = state.timeSinceJump;
+    saved.random = state.random;
+}
+
+//whether anything changed other than the time and the timers
+bool RAM_FUNC(sameApartFromTime)(const changeablestate &a, const changeablestate &b) {
+    return a.prevX == b.prevX && a.prevY == b.prevY &&
+           a.currentIndexA == b.currentIndexA && a.currentIndexSDI == b.currentIndexSDI &&
+           a.currentA.timestamp == b.currentA.timestamp && a.currentA.tt == b.currentA.tt &&
+           a.currentA.x == b.currentA.x && a.currentA.y == b.currentA.y &&
+           a.currentA.x_start == b.currentA.x_start && a.currentA.y_start == b.currentA.y_start &&
+           a.currentA.x_end == b.currentA.x_end && a.currentA.y_end == b.currentA.y_end &&
+           a.newestPivotTime == b.newestPivotTime && a.staleZones == b.staleZones &&
+           a.delayType == b.delayType && a.doneTraveling == b.doneTraveling &&
+           a.wavedashWasNerfed == b.wavedashWasNerfed && a.sdiIsNerfed == b.sdiIsNerfed &&
+           a.downUpJumping == b.downUpJumping && a.sdiCountdown == b.sdiCountdown &&
+           a.random.value == b.random.value && a.random.seeded == b.random.seeded;
+}
+
+MeleeLimiter::MeleeLimiter() {
+    _state.random.seeded = false;
+    Reset();
+}
+
+void MeleeLimiter::Reset() {
+    _state.initialized = false;
+    _state.quiet = false;
+}
+
+const MeleeLimiterState &MeleeLimiter::SaveState() const {
+    return _state;
+}
+
+void MeleeLimiter::Restore(const MeleeLimiterState &state) {
+    _state = state;
+}
+
+void RAM_FUNC(MeleeLimiter::LimitOutputs)(const uint32_t sampleTimeUs,
                   const abtest whichAB,
                   const InputState &inputs,
                   const OutputState &rawOutputIn,
                   OutputState &finalOutput) {
+    const bool sameInputs = _state.initialized &&
+                            inputs.buttons == _state.prevButtons &&
+                            same_outputs(rawOutputIn, _state.prevRaw);
+    if(sameInputs && _state.quiet && sampleTimeUs - _state.quietSince < _state.quietFor) {
+        //nothing can have changed, other than the timers counting up as they would have
+        const uint32_t sampleSpacing = sampleTimeUs - _state.prevTime;
+        _state.prevTime = sampleTimeUs;
+        if(_state.quietCounting & COUNTING_NOTUPTILT) {
+            _state.timeSinceNotUptilt = advanceTimer(_state.timeSinceNotUptilt, sampleSpacing, TIMELIMIT_TAPSHUTOFF+1);
+        }
+        if(_state.quietCounting & COUNTING_CROUCH) {
+            _state.timeSinceCrouch = advanceTimer(_state.timeSinceCrouch, sampleSpacing, TIMELIMIT_DOWNUP);
+        }
+        if(_state.quietCounting & COUNTING_JUMP) {
+            _state.timeSinceJump = advanceTimer(_state.timeSinceJump, sampleSpacing, JUMP_TIME);
+        }
+        finalOutput = _state.quietOutput;
+        return;
+    }
+
+    //to tell whether the full pass changes anything other than the time
+    changeablestate before;
+    if(sameInputs) {
+        saveChangeable(_state, before);
+    }
+
+    ComputeOutputs(sampleTimeUs, inputs, rawOutputIn, finalOutput);
+
+    //while traveling or counting down, the outputs or state change with time even if nothing else does
+    //a full pass at the same time as the last can't tell whether the timers are counting
+    bool quiet = false;
+    if(sameInputs && _state.doneTraveling && _state.sdiCountdown == 0 && sampleTimeUs != before.prevTime) {
+        //a timer that went up is counting, and keeps counting as long as the inputs stay the same
+        uint8_t counting = 0;
+        if(_state.timeSinceNotUptilt > before.timeSinceNotUptilt) {
+            counting |= COUNTING_NOTUPTILT;
+        }
+        if(_state.timeSinceCrouch > before.timeSinceCrouch) {
+            counting |= COUNTING_CROUCH;
+        }
+        if(_state.timeSinceJump > before.timeSinceJump) {
+            counting |= COUNTING_JUMP;
+        }
+        changeablestate after;
+        saveChangeable(_state, after);
+        quiet = sameApartFromTime(before, after);
+        _state.quietCounting = counting;
+    }
+    _state.quiet = quiet;
+    if(quiet) {
+        _state.quietSince = sampleTimeUs;
+        _state.quietFor = timeUntilChange(_state, sampleTimeUs);
+        _state.quietOutput = finalOutput;
+    }
+    _state.prevRaw = rawOutputIn;
+}
+
+void RAM_FUNC(MeleeLimiter::ComputeOutputs)(const uint32_t sampleTimeUs,
+                  const InputState &inputs,
+                  const OutputState &rawOutputIn,
+                  OutputState &finalOutput) {
     //First, we want to check if the raw output has changed.
     //If it has changed, then we need to store it with a timestamp in our buffer.
     //Also check whether it's an "easy" coordinate or not (rim+origin = easy)
@@ -498,21 +681,25 @@ void limitOutputs(const uint16_t sampleSpacing,//in units of 4us
     //  rapid eighth-circling (cardinal diagonal neutral repeat)
     //    Increase travel time on cardinal and lock out later diagonals.
 
-    static bool doneTraveling = true;
-
-    static uint16_t currentTime = 0;
-    currentTime++;
-
-    static shortstate aHistory[HISTORYLEN];
-    static sdizonestate sdiZoneHist[HISTORYLEN];
-    static pivotzonestate pivotZoneHist[HISTORYLEN];
-
-    static InputState prevInputs;
-
-    static bool initialized = false;
-    if(!initialized) {
+    //the limiter's state, under the names used below
+    shortstate *aHistory = _state.aHistory;
+    sdizonestate *sdiZoneHist = _state.sdiZoneHist;
+    pivotzonestate *pivotZoneHist = _state.pivotZoneHist;
+    uint8_t &currentIndexA = _state.currentIndexA;
+    uint8_t &currentIndexSDI = _state.currentIndexSDI;
+    uint32_t &prevButtons = _state.prevButtons;
+    travelType &delayType = _state.delayType;
+    bool &doneTraveling = _state.doneTraveling;
+    randomstate &random = _state.random;
+
+    //the history is timestamped in us; differences between timestamps are exact across wraparound
+    const uint32_t currentTime = sampleTimeUs;
+    uint32_t sampleSpacing = currentTime - _state.prevTime;//time since the previous sample
+    _state.prevTime = currentTime;
+
+    if(!_state.initialized) {
         for(int i = 0; i<HISTORYLEN; i++) {
-            aHistory[i].timestamp = 0;
+            aHistory[i].timestamp = currentTime;
             aHistory[i].tt = 6;
             aHistory[i].x = ANALOG_STICK_NEUTRAL;
             aHistory[i].y = ANALOG_STICK_NEUTRAL;
@@ -520,36 +707,43 @@ void limitOutputs(const uint16_t sampleSpacing,//in units of 4us
             aHistory[i].y_start = ANALOG_STICK_NEUTRAL;
             aHistory[i].x_end = ANALOG_STICK_NEUTRAL;
             aHistory[i].y_end = ANALOG_STICK_NEUTRAL;
-            sdiZoneHist[i].timestamp = 0;
+            sdiZoneHist[i].timestamp = currentTime;
             sdiZoneHist[i].zone = 0;
             sdiZoneHist[i].stale = true;
-            pivotZoneHist[i].timestamp = 0;
+            pivotZoneHist[i].timestamp = currentTime;
             pivotZoneHist[i].zone = 0;
             pivotZoneHist[i].stale = true;
         }
+        currentIndexA = 0;
+        currentIndexSDI = 0;
         //track the inputs that can cause changes to coordinates
-        prevInputs.left = inputs.left;
-        prevInputs.right = inputs.right;
-        prevInputs.down = inputs.down;
-        prevInputs.up = inputs.up;
-        prevInputs.c_left = inputs.c_left;
-        prevInputs.c_right = inputs.c_right;
-        prevInputs.c_down = inputs.c_down;
-        prevInputs.c_up = inputs.c_up;
-        prevInputs.b = inputs.b;
-        prevInputs.l = inputs.l;//we don't care about recording these
-        prevInputs.r = inputs.r;
-        prevInputs.lightshield = inputs.lightshield;
-        prevInputs.midshield = inputs.midshield;
-        prevInputs.mod_x = inputs.mod_x;
-        prevInputs.mod_y = inputs.mod_y;
-
-        initialized = true;
-    }
-    static uint8_t currentIndexA = 0;
-    static uint8_t currentIndexSDI = 0;
+        prevButtons = inputs.buttons;
+        _state.prevX = rawOutputIn.leftStickX;
+        _state.prevY = rawOutputIn.leftStickY;
+
+        delayType = T_Lin;
+        doneTraveling = true;
+        _state.wavedashWasNerfed = false;
+        _state.sdiIsNerfed = false;
+        _state.downUpJumping = false;
+        _state.sdiCountdown = 0;
+        _state.timeSinceNotUptilt = 0;
+        _state.timeSinceCrouch = TIMELIMIT_DOWNUP;
+        _state.timeSinceJump = JUMP_TIME;
+
+        sampleSpacing = 0;
 
-    static travelType delayType = T_Lin;
+        _state.initialized = true;
+    }
+    //after a long enough gap, old timestamps could wrap around into the recent past
+    if(sampleSpacing > TIMELIMIT_HISTORY) {
+        for(int i = 0; i<HISTORYLEN; i++) {
+            sdiZoneHist[i].stale = true;
+            pivotZoneHist[i].stale = true;
+        }
+        doneTraveling = true;
+        sampleSpacing = TIMELIMIT_HISTORY;
+    }
 
     //calculate whether to do a airdodge travel adjustment or not
     //we want to continue the previous travel time, but if it's an airdodge with a prohibited angle destination, we overwrite the angle.
@@ -567,7 +761,7 @@ void limitOutputs(const uint16_t sampleSpacing,//in units of 4us
     //if L or R has just been released
     // if it was nerfing them, un-nerf them
     bool wavedashSkip = false;
-    static bool wavedashWasNerfed = false;
+    bool &wavedashWasNerfed = _state.wavedashWasNerfed;
     if(inputs.l || inputs.r) {
         //check angles to see if it's in a shallow wavedash region
         //the trigger was the only input that changed, potentially causing a retargeting without restarting the travel time
@@ -607,7 +801,7 @@ void limitOutputs(const uint16_t sampleSpacing,//in units of 4us
                     y_end = ANALOG_STICK_NEUTRAL + yWavedash;
                 }
                 //fuzz it
-                randomizeCoord(x_end, y_end, currentTime);
+                randomizeCoord(x_end, y_end, currentTime, random);
                 //write it back
                 aHistory[currentIndexA].x_end = x_end;
                 aHistory[currentIndexA].y_end = y_end;
@@ -619,26 +813,12 @@ void limitOutputs(const uint16_t sampleSpacing,//in units of 4us
             } else {
                 wavedashWasNerfed = false;
                 //only skip inputs if the L or R press caused the change in coordinates
-                if(!(prevInputs.l || prevInputs.r)) {
+                if(!(prevButtons & TRIGGER_INPUTS)) {
                     //check if the L/R press coincides with a change in coordinate, indicating L/R NDM
-                    if(
-                        prevInputs.left == inputs.left &&
-                        prevInputs.right == inputs.right &&
-                        prevInputs.down == inputs.down &&
-                        prevInputs.up == inputs.up &&
-                        prevInputs.c_left == inputs.c_left &&
-                        prevInputs.c_right == inputs.c_right &&
-                        prevInputs.c_down == inputs.c_down &&
-                        prevInputs.c_up == inputs.c_up &&
-                        prevInputs.b == inputs.b &&
-                        prevInputs.lightshield == inputs.lightshield &&
-                        prevInputs.midshield == inputs.midshield &&
-                        prevInputs.mod_x == inputs.mod_x &&
-                        prevInputs.mod_y == inputs.mod_y
-                    ) {
+                    if(!((prevButtons ^ inputs.buttons) & COORD_INPUTS)) {
                         //then we need to skip to the new coordinate
                         //fuzz it
-                        randomizeCoord(x_end, y_end, currentTime);
+                        randomizeCoord(x_end, y_end, currentTime, random);
                         //write it back
                         aHistory[currentIndexA].x_end = x_end;
                         aHistory[currentIndexA].y_end = y_end;
@@ -669,14 +849,14 @@ void limitOutputs(const uint16_t sampleSpacing,//in units of 4us
                 y_end = ANALOG_STICK_NEUTRAL + yWavedash;
             }
             //fuzz it
-            randomizeCoord(x_end, y_end, currentTime);
+            randomizeCoord(x_end, y_end, currentTime, random);
             //write it back
             aHistory[currentIndexA].x_end = x_end;
             aHistory[currentIndexA].y_end = y_end;
             //mark as having been nerfed so we can undo it later
             wavedashWasNerfed = true;
         }
-    } else if(!(inputs.l || inputs.r) && (prevInputs.l || prevInputs.r)) {
+    } else if(!(inputs.l || inputs.r) && (prevButtons & TRIGGER_INPUTS)) {
         //if nerfed, then de-nerf once L and R are no longer pressed
         if(wavedashWasNerfed) {
             const uint8_t xIn = rawOutputIn.leftStickX;
@@ -684,7 +864,7 @@ void limitOutputs(const uint16_t sampleSpacing,//in units of 4us
             uint8_t x_end = xIn;
             uint8_t y_end = yIn;
             //fuzz it again
-            randomizeCoord(x_end, y_end, currentTime);
+            randomizeCoord(x_end, y_end, currentTime, random);
             //write it back
             aHistory[currentIndexA].x_end = x_end;
             aHistory[currentIndexA].y_end = y_end;
@@ -692,21 +872,7 @@ void limitOutputs(const uint16_t sampleSpacing,//in units of 4us
         }
     }
     //record previous inputs
-    prevInputs.left = inputs.left;
-    prevInputs.right = inputs.right;
-    prevInputs.down = inputs.down;
-    prevInputs.up = inputs.up;
-    prevInputs.c_left = inputs.c_left;
-    prevInputs.c_right = inputs.c_right;
-    prevInputs.c_down = inputs.c_down;
-    prevInputs.c_up = inputs.c_up;
-    prevInputs.b = inputs.b;
-    prevInputs.l = inputs.l;//we don't care about recording these
-    prevInputs.r = inputs.r;
-    prevInputs.lightshield = inputs.lightshield;
-    prevInputs.midshield = inputs.midshield;
-    prevInputs.mod_x = inputs.mod_x;
-    prevInputs.mod_y = inputs.mod_y;
+    prevButtons = inputs.buttons;
 
     //calculate travel from the previous step
     uint8_t prelimAX = rawOutputIn.leftStickX;
@@ -715,14 +881,14 @@ void limitOutputs(const uint16_t sampleSpacing,//in units of 4us
     uint8_t prelimCY = rawOutputIn.rightStickY;
 
     //test for SDI in the raw inputs
-    const uint8_t tapSDI = isTapSDI(sdiZoneHist, currentIndexSDI, currentTime, sampleSpacing);
+    const uint8_t tapSDI = isTapSDI(sdiZoneHist, currentIndexSDI, currentTime);
     //if cardinal tap SDI
     if(tapSDI & BITS_SDI_TAP_CARD) {
         aHistory[currentIndexA].tt = max(aHistory[currentIndexA].tt, TRAVELTIME_SLOW);
         delayType = T_Lin;
     }
     //if oscillating about a diagonal
-    static uint16_t sdiCountdown = 0;
+    uint32_t &sdiCountdown = _state.sdiCountdown;
     if((tapSDI & BITS_SDI_WANK) && (tapSDI & BITS_SDI_TAP_CRDG)) {
         //both wank&cardiag indicates that it was oscillating about a diagonal
         //new destinations will have 5.5 frame travel time for a duration of 4 frames from the last sdi detection event
@@ -738,7 +904,6 @@ void limitOutputs(const uint16_t sampleSpacing,//in units of 4us
 
     travelTimeCalc(currentTime,
                    aHistory[currentIndexA].timestamp,
-                   sampleSpacing,
                    aHistory[currentIndexA].tt,
                    aHistory[currentIndexA].x_start,
                    aHistory[currentIndexA].y_start,
@@ -764,7 +929,7 @@ void limitOutputs(const uint16_t sampleSpacing,//in units of 4us
         pivotZoneHist[0].stale = false;
     }
     for(int i = 0; i < HISTORYLEN; i++) {
-        if((currentTime-pivotZoneHist[i].timestamp) * (sampleSpacing>>1) > 15*16*125) { //15 frames
+        if(currentTime-pivotZoneHist[i].timestamp > TIMELIMIT_PIVOT_STALE) {
             pivotZoneHist[i].stale = true;
         }
     }
@@ -786,7 +951,7 @@ void limitOutputs(const uint16_t sampleSpacing,//in units of 4us
             direction = P_Leftright;
         }
     }
-    uint16_t pivotLength = (pivotZoneHist[0].timestamp - pivotZoneHist[1].timestamp)*sampleSpacing;
+    const uint32_t pivotLength = pivotZoneHist[0].timestamp - pivotZoneHist[1].timestamp;
     if(pivotLength < TIMELIMIT_HALFFRAME || pivotLength > TIMELIMIT_FRAME+TIMELIMIT_HALFFRAME) {
         //less than 50% chance it was a successful pivot
         direction = P_None;
@@ -797,19 +962,19 @@ void limitOutputs(const uint16_t sampleSpacing,//in units of 4us
         direction = P_None;
     }
 
-    uint16_t pivotAge = (currentTime - pivotZoneHist[0].timestamp)*sampleSpacing;
+    const uint32_t pivotAge = currentTime - pivotZoneHist[0].timestamp;
     if(pivotAge > TIMELIMIT_PIVOTTILT) {
         direction = P_None;
     }
 
     //tap jump shutoff
-    static uint8_t uptiltSamples = 0;
+    //only counted up to just past the limit
+    uint32_t &timeSinceNotUptilt = _state.timeSinceNotUptilt;
     if(prelimAY > ANALOG_DEAD_MAX) {
-        uptiltSamples = min(uptiltSamples+1,254);
+        timeSinceNotUptilt = advanceTimer(timeSinceNotUptilt, sampleSpacing, TIMELIMIT_TAPSHUTOFF+1);
     } else {
-        uptiltSamples = 0;
+        timeSinceNotUptilt = 0;
     }
-    const uint16_t timeSinceNotUptilt = uptiltSamples*sampleSpacing;
 
     //actually apply the nerfs
     //debug c-stick output
@@ -861,19 +1026,20 @@ void limitOutputs(const uint16_t sampleSpacing,//in units of 4us
     }
 
     //if it's a crouch to upward coordinate too quickly, make Y jump even if a tilt was desired
-    static uint16_t timeSinceCrouch = 100;//must be < 65535 when multiplied by 500, the longest possible sampleSpacing, but bigger than the (timelimit/250)
-    static bool downUpJumping;
-    static uint16_t timeSinceJump = 100;
+    //only counted up to the time limits
+    uint32_t &timeSinceCrouch = _state.timeSinceCrouch;
+    bool &downUpJumping = _state.downUpJumping;
+    uint32_t &timeSinceJump = _state.timeSinceJump;
 
     //increment timeSinceCrouch unless you have crouched
-    timeSinceCrouch = min(timeSinceCrouch+1, 100);
+    timeSinceCrouch = advanceTimer(timeSinceCrouch, sampleSpacing, TIMELIMIT_DOWNUP);
     if(prelimAY < ANALOG_CROUCH) {
         timeSinceCrouch = 0;
     }
 
     //increment timeSinceJump unless you want to trigger a jump
-    timeSinceJump = min(timeSinceJump+1, 100);
-    if(timeSinceCrouch*sampleSpacing < TIMELIMIT_DOWNUP
+    timeSinceJump = advanceTimer(timeSinceJump, sampleSpacing, JUMP_TIME);
+    if(timeSinceCrouch < TIMELIMIT_DOWNUP
         && prelimAY > ANALOG_DEAD_MAX
         && prelimAY < ANALOG_TAPJUMP
         && prelimAX > ANALOG_UTILT_LEFT
@@ -883,16 +1049,16 @@ void limitOutputs(const uint16_t sampleSpacing,//in units of 4us
         timeSinceJump = 0;
     }
 
-    if(timeSinceJump*sampleSpacing < JUMP_TIME && downUpJumping) {
+    if(timeSinceJump < JUMP_TIME && downUpJumping) {
         prelimAY = 255;
-        timeSinceCrouch = 100;//prevent an extra duration jump if the jump ends before the lockout window
+        timeSinceCrouch = TIMELIMIT_DOWNUP;//prevent an extra duration jump if the jump ends before the lockout window
     } else {
         downUpJumping = false;
     }
 
     //if it's wank sdi (TODO) or diagonal tap SDI, lock out the cross axis
     //we use the sdi variable from earlier
-    static bool sdiIsNerfed = false;//only for lockouts, not travel time
+    bool &sdiIsNerfed = _state.sdiIsNerfed;//only for lockouts, not travel time
     if(tapSDI & (BITS_SDI_TAP_DIAG | BITS_SDI_TAP_CRDG | BITS_SDI_WANK)){
         if(tapSDI & (ZONE_L | ZONE_R)) {
             //lock the cross axis
@@ -950,7 +1116,7 @@ void limitOutputs(const uint16_t sampleSpacing,//in units of 4us
         sdiZoneHist[currentIndexSDI].stale = false;
     }
     for(int i = 0; i < HISTORYLEN; i++) {
-        if(currentTime-sdiZoneHist[i].timestamp > 8*16*2) {//8 frames * 16 ms * max 2 samples
+        if(currentTime-sdiZoneHist[i].timestamp > TIMELIMIT_SDI_STALE) {
             sdiZoneHist[i].stale = true;
         }
     }
@@ -958,8 +1124,8 @@ void limitOutputs(const uint16_t sampleSpacing,//in units of 4us
     //if we have a new coordinate, record the new info, the travel time'd locked out stick coordinate, and set travel time
     const uint8_t xIn = rawOutputIn.leftStickX;
     const uint8_t yIn = rawOutputIn.leftStickY;
-    static uint8_t prevX = xIn;
-    static uint8_t prevY = yIn;
+    uint8_t &prevX = _state.prevX;
+    uint8_t &prevY = _state.prevY;
     //prelimAY = 5*currentIndexA;//we found that there are no new inputs causing the jumps
     //prelimAY = currentTime % 256;//we found that time isn't jumping
     if(prevX != xIn || prevY != yIn) {
@@ -974,7 +1140,7 @@ void limitOutputs(const uint16_t sampleSpacing,//in units of 4us
 
             uint8_t xInRand = xIn;
             uint8_t yInRand = yIn;
-            randomizeCoord(xInRand, yInRand, currentTime);
+            randomizeCoord(xInRand, yInRand, currentTime, random);
 
             aHistory[currentIndexA].timestamp = currentTime;
             aHistory[currentIndexA].x = xIn;
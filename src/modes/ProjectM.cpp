@@ -5,13 +5,13 @@
 #define ANALOG_STICK_MAX 228
 
 ProjectM::ProjectM(socd::SocdType socd_type, ProjectMOptions options) {
-    _socd_pair_count = 4;
-    _socd_pairs = new socd::SocdPair[_socd_pair_count]{
-        socd::SocdPair{&InputState::left,    &InputState::right,   socd_type},
-        socd::SocdPair{ &InputState::down,   &InputState::up,      socd_type},
-        socd::SocdPair{ &InputState::c_left, &InputState::c_right, socd_type},
-        socd::SocdPair{ &InputState::c_down, &InputState::c_up,    socd_type},
+    const socd::SocdPair socd_pairs[] = {
+        socd::SocdPair{InputBit::left,    InputBit::right,   socd_type},
+        socd::SocdPair{ InputBit::down,   InputBit::up,      socd_type},
+        socd::SocdPair{ InputBit::c_left, InputBit::c_right, socd_type},
+        socd::SocdPair{ InputBit::c_down, InputBit::c_up,    socd_type},
     };
+    SetSocdPairs(socd_pairs);
 
     _options = options;
     _horizontal_socd = false;
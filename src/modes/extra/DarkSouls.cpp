@@ -4,67 +4,61 @@
 #define ANALOG_STICK_NEUTRAL 128
 #define ANALOG_STICK_MAX 255
 
-DarkSouls::DarkSouls(socd::SocdType socd_type) {
-    _socd_pair_count = 4;
-    _socd_pairs = new socd::SocdPair[_socd_pair_count]{
-        socd::SocdPair{&InputState::left,    &InputState::right,   socd_type},
-        socd::SocdPair{ &InputState::down,   &InputState::mod_x,   socd_type},
-        socd::SocdPair{ &InputState::c_left, &InputState::c_right, socd_type},
-        socd::SocdPair{ &InputState::c_down, &InputState::c_up,    socd_type},
-    };
-}
+// Base layer, secondary layer when X is held, and DPad layer when Nunchuk C is held.
+#define LAYER_0 0, input_mask(InputBit::x, InputBit::nunchuk_c)
+#define LAYER_X input_mask(InputBit::x), input_mask(InputBit::nunchuk_c)
+#define LAYER_C input_mask(InputBit::nunchuk_c), 0
 
-void DarkSouls::UpdateDigitalOutputs(InputState &inputs, OutputState &outputs) {
-    outputs.y = inputs.y;
-    outputs.x = inputs.r;
+constexpr OutputMapping output_mappings[] MODE_TABLE = {
+    remap(InputBit::y, OutputBit::y),
+    remap(InputBit::r, OutputBit::x),
 
-    // Base layer.
-    bool layer0 = !inputs.x && !inputs.nunchuk_c;
-    // Secondary layer when X is held.
-    bool layerX = inputs.x && !inputs.nunchuk_c;
-    // DPad layer when Nunchuk C is held.
-    bool layerC = inputs.nunchuk_c;
+    remap(InputBit::a, OutputBit::a, LAYER_0),
+    remap(InputBit::b, OutputBit::b, LAYER_0),
+    remap(InputBit::z, OutputBit::buttonR, LAYER_0),
+    remap(InputBit::up, OutputBit::buttonL, LAYER_0),
+    remap(InputBit::start, OutputBit::start, LAYER_0),
+    remap(InputBit::nunchuk_z, OutputBit::start, LAYER_0),
 
-    if (layer0) {
-        outputs.a = inputs.a;
-        outputs.b = inputs.b;
-        outputs.buttonR = inputs.z;
-        outputs.buttonL = inputs.up;
-        outputs.start = inputs.start | inputs.nunchuk_z;
-    } else if (layerX) {
-        outputs.rightStickClick = inputs.a;
-        outputs.triggerRDigital = inputs.z;
-        outputs.triggerLDigital = inputs.up;
-        outputs.select = inputs.start;
-    } else if (layerC) {
-        outputs.a = inputs.a;
-        outputs.dpadLeft = inputs.b;
-        outputs.dpadDown = inputs.x;
-        outputs.dpadUp = inputs.z;
-        outputs.dpadRight = inputs.up;
-        outputs.select = inputs.nunchuk_z;
-    }
-}
+    remap(InputBit::a, OutputBit::rightStickClick, LAYER_X),
+    remap(InputBit::z, OutputBit::triggerRDigital, LAYER_X),
+    remap(InputBit::up, OutputBit::triggerLDigital, LAYER_X),
+    remap(InputBit::start, OutputBit::select, LAYER_X),
 
-void DarkSouls::UpdateAnalogOutputs(InputState &inputs, OutputState &outputs) {
-    UpdateDirections(
-        inputs.left,
-        inputs.right,
-        inputs.down,
-        inputs.mod_x,
-        inputs.c_left,
-        inputs.c_right,
-        inputs.c_down,
-        inputs.c_up,
-        ANALOG_STICK_MIN,
-        ANALOG_STICK_NEUTRAL,
-        ANALOG_STICK_MAX,
-        outputs
-    );
+    remap(InputBit::a, OutputBit::a, LAYER_C),
+    remap(InputBit::b, OutputBit::dpadLeft, LAYER_C),
+    remap(InputBit::x, OutputBit::dpadDown, LAYER_C),
+    remap(InputBit::z, OutputBit::dpadUp, LAYER_C),
+    remap(InputBit::up, OutputBit::dpadRight, LAYER_C),
+    remap(InputBit::nunchuk_z, OutputBit::select, LAYER_C),
+};
 
-    // Nunchuk overrides left stick.
-    if (inputs.nunchuk_connected) {
-        outputs.leftStickX = inputs.nunchuk_x;
-        outputs.leftStickY = inputs.nunchuk_y;
-    }
+static const TableModeLayout layout = {
+    .left = input_mask(InputBit::left),
+    .right = input_mask(InputBit::right),
+    .down = input_mask(InputBit::down),
+    .up = input_mask(InputBit::mod_x),
+    .c_left = input_mask(InputBit::c_left),
+    .c_right = input_mask(InputBit::c_right),
+    .c_down = input_mask(InputBit::c_down),
+    .c_up = input_mask(InputBit::c_up),
+    .analog_stick_min = ANALOG_STICK_MIN,
+    .analog_stick_neutral = ANALOG_STICK_NEUTRAL,
+    .analog_stick_max = ANALOG_STICK_MAX,
+    .output_mappings = output_mappings,
+    .output_mapping_count = sizeof(output_mappings) / sizeof(OutputMapping),
+    .coordinate_rows = nullptr,
+    .coordinate_row_count = 0,
+    .trigger_analog = 0,
+    .nunchuk_left_stick = true,
+};
+
+DarkSouls::DarkSouls(socd::SocdType socd_type) : TableMode(layout) {
+    const socd::SocdPair socd_pairs[] = {
+        socd::SocdPair{InputBit::left,    InputBit::right,   socd_type},
+        socd::SocdPair{ InputBit::down,   InputBit::mod_x,   socd_type},
+        socd::SocdPair{ InputBit::c_left, InputBit::c_right, socd_type},
+        socd::SocdPair{ InputBit::c_down, InputBit::c_up,    socd_type},
+    };
+    SetSocdPairs(socd_pairs);
 }
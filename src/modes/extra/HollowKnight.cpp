@@ -4,43 +4,46 @@
 #define ANALOG_STICK_NEUTRAL 128
 #define ANALOG_STICK_MAX 255
 
-HollowKnight::HollowKnight(socd::SocdType socd_type) {
-    _socd_pair_count = 4;
-    _socd_pairs = new socd::SocdPair[_socd_pair_count]{
-        socd::SocdPair{&InputState::left,    &InputState::right,   socd_type},
-        socd::SocdPair{ &InputState::down,   &InputState::mod_x,   socd_type},
-        socd::SocdPair{ &InputState::c_left, &InputState::c_right, socd_type},
-        socd::SocdPair{ &InputState::c_down, &InputState::c_up,    socd_type},
-    };
-}
+constexpr OutputMapping output_mappings[] MODE_TABLE = {
+    remap(InputBit::a, OutputBit::a), // Attack
+    remap(InputBit::b, OutputBit::b), // Dash
+    remap(InputBit::x, OutputBit::x), // Jump
+    remap(InputBit::mod_y, OutputBit::y), // Quick Cast
+    remap(InputBit::r, OutputBit::triggerLDigital), // Focus / Cast
+    remap(InputBit::z, OutputBit::triggerRDigital), // C-Dash
+    remap(InputBit::up, OutputBit::buttonR), // Dream Nail
 
-void HollowKnight::UpdateDigitalOutputs(InputState &inputs, OutputState &outputs) {
-    outputs.a = inputs.a; // Attack
-    outputs.b = inputs.b; // Dash
-    outputs.x = inputs.x; // Jump
-    outputs.y = inputs.mod_y; // Quick Cast
-    outputs.triggerLDigital = inputs.r; // Focus / Cast
-    outputs.triggerRDigital = inputs.z; // C-Dash
-    outputs.buttonR = inputs.up; // Dream Nail
+    remap(InputBit::lightshield, OutputBit::buttonL), // Map
+    remap(InputBit::midshield, OutputBit::select), // Inventory
+    remap(InputBit::start, OutputBit::start), // Pause
+};
 
-    outputs.buttonL = inputs.lightshield; // Map
-    outputs.select = inputs.midshield; // Inventory
-    outputs.start = inputs.start; // Pause
-}
+static const TableModeLayout layout = {
+    .left = input_mask(InputBit::left),
+    .right = input_mask(InputBit::right),
+    .down = input_mask(InputBit::down),
+    .up = input_mask(InputBit::mod_x),
+    .c_left = input_mask(InputBit::c_left),
+    .c_right = input_mask(InputBit::c_right),
+    .c_down = input_mask(InputBit::c_down),
+    .c_up = input_mask(InputBit::c_up),
+    .analog_stick_min = ANALOG_STICK_MIN,
+    .analog_stick_neutral = ANALOG_STICK_NEUTRAL,
+    .analog_stick_max = ANALOG_STICK_MAX,
+    .output_mappings = output_mappings,
+    .output_mapping_count = sizeof(output_mappings) / sizeof(OutputMapping),
+    .coordinate_rows = nullptr,
+    .coordinate_row_count = 0,
+    .trigger_analog = 0,
+    .nunchuk_left_stick = false,
+};
 
-void HollowKnight::UpdateAnalogOutputs(InputState &inputs, OutputState &outputs) {
-    UpdateDirections(
-        inputs.left,
-        inputs.right,
-        inputs.down,
-        inputs.mod_x,
-        inputs.c_left,
-        inputs.c_right,
-        inputs.c_down,
-        inputs.c_up,
-        ANALOG_STICK_MIN,
-        ANALOG_STICK_NEUTRAL,
-        ANALOG_STICK_MAX,
-        outputs
-    );
+HollowKnight::HollowKnight(socd::SocdType socd_type) : TableMode(layout) {
+    const socd::SocdPair socd_pairs[] = {
+        socd::SocdPair{InputBit::left,    InputBit::right,   socd_type},
+        socd::SocdPair{ InputBit::down,   InputBit::mod_x,   socd_type},
+        socd::SocdPair{ InputBit::c_left, InputBit::c_right, socd_type},
+        socd::SocdPair{ InputBit::c_down, InputBit::c_up,    socd_type},
+    };
+    SetSocdPairs(socd_pairs);
 }
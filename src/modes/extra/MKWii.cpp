@@ -4,50 +4,41 @@
 #define ANALOG_STICK_NEUTRAL 128
 #define ANALOG_STICK_MAX 255
 
-MKWii::MKWii(socd::SocdType socd_type) {
-    _socd_pair_count = 4;
-    _socd_pairs = new socd::SocdPair[_socd_pair_count]{
-        socd::SocdPair{&InputState::left, &InputState::right, socd_type},
-        socd::SocdPair{ &InputState::l,   &InputState::down,  socd_type},
-        socd::SocdPair{ &InputState::l,   &InputState::mod_x, socd_type},
-        socd::SocdPair{ &InputState::l,   &InputState::mod_y, socd_type},
-    };
-}
-
-void MKWii::UpdateDigitalOutputs(InputState &inputs, OutputState &outputs) {
-    outputs.a = inputs.b;
-    outputs.b = inputs.x;
-    outputs.triggerLDigital = inputs.z;
-    outputs.buttonR = inputs.up;
-    outputs.dpadUp = inputs.a;
-    outputs.start = inputs.start;
-}
+constexpr OutputMapping output_mappings[] MODE_TABLE = {
+    remap(InputBit::b, OutputBit::a),
+    remap(InputBit::x, OutputBit::b),
+    remap(InputBit::z, OutputBit::triggerLDigital),
+    remap(InputBit::up, OutputBit::buttonR),
+    remap(InputBit::a, OutputBit::dpadUp),
+    remap(InputBit::start, OutputBit::start),
+};
 
-void MKWii::UpdateAnalogOutputs(InputState &inputs, OutputState &outputs) {
-    bool up = inputs.down || inputs.mod_x || inputs.mod_y;
+static const TableModeLayout layout = {
+    .left = input_mask(InputBit::left),
+    .right = input_mask(InputBit::right),
+    .down = input_mask(InputBit::l),
+    .up = input_mask(InputBit::down, InputBit::mod_x, InputBit::mod_y),
+    .c_left = 0,
+    .c_right = 0,
+    .c_down = 0,
+    .c_up = 0,
+    .analog_stick_min = ANALOG_STICK_MIN,
+    .analog_stick_neutral = ANALOG_STICK_NEUTRAL,
+    .analog_stick_max = ANALOG_STICK_MAX,
+    .output_mappings = output_mappings,
+    .output_mapping_count = sizeof(output_mappings) / sizeof(OutputMapping),
+    .coordinate_rows = nullptr,
+    .coordinate_row_count = 0,
+    .trigger_analog = 140,
+    .nunchuk_left_stick = true,
+};
 
-    UpdateDirections(
-        inputs.left,
-        inputs.right,
-        inputs.l,
-        up,
-        false,
-        false,
-        false,
-        false,
-        ANALOG_STICK_MIN,
-        ANALOG_STICK_NEUTRAL,
-        ANALOG_STICK_MAX,
-        outputs
-    );
-
-    if (inputs.z) {
-        outputs.triggerLAnalog = 140;
-    }
-
-    // Nunchuk overrides left stick.
-    if (inputs.nunchuk_connected) {
-        outputs.leftStickX = inputs.nunchuk_x;
-        outputs.leftStickY = inputs.nunchuk_y;
-    }
+MKWii::MKWii(socd::SocdType socd_type) : TableMode(layout) {
+    const socd::SocdPair socd_pairs[] = {
+        socd::SocdPair{InputBit::left, InputBit::right, socd_type},
+        socd::SocdPair{ InputBit::l,   InputBit::down,  socd_type},
+        socd::SocdPair{ InputBit::l,   InputBit::mod_x, socd_type},
+        socd::SocdPair{ InputBit::l,   InputBit::mod_y, socd_type},
+    };
+    SetSocdPairs(socd_pairs);
 }
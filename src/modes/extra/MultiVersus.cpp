@@ -4,124 +4,96 @@
 #define ANALOG_STICK_NEUTRAL 128
 #define ANALOG_STICK_MAX 255
 
-MultiVersus::MultiVersus(socd::SocdType socd_type) {
-    _socd_pair_count = 4;
-    _socd_pairs = new socd::SocdPair[_socd_pair_count]{
-        socd::SocdPair{&InputState::left,    &InputState::right,   socd_type},
-        socd::SocdPair{ &InputState::down,   &InputState::up,      socd_type},
-        socd::SocdPair{ &InputState::c_left, &InputState::c_right, socd_type},
-        socd::SocdPair{ &InputState::c_down, &InputState::c_up,    socd_type},
-    };
-}
+#define MX input_mask(InputBit::mod_x)
+#define MY input_mask(InputBit::mod_y)
+#define NUNCHUK input_mask(InputBit::nunchuk_connected)
 
-void MultiVersus::UpdateDigitalOutputs(InputState &inputs, OutputState &outputs) {
+constexpr OutputMapping output_mappings[] MODE_TABLE = {
     // Bind X and Y to "jump" in-game.
-    outputs.x = inputs.x;
-    outputs.y = inputs.y;
+    remap(InputBit::x, OutputBit::x),
+    remap(InputBit::y, OutputBit::y),
 
-    outputs.start = !inputs.mod_y && inputs.start;
+    remap(InputBit::start, OutputBit::start, 0, MY),
 
     // Select, MS, or MY + Start for "Reset" in the Lab. Not supported by GameCube adapter.
-    outputs.select = inputs.select || inputs.midshield || (inputs.mod_y && inputs.start);
+    remap(InputBit::select, OutputBit::select),
+    remap(InputBit::midshield, OutputBit::select),
+    remap(InputBit::start, OutputBit::select, MY),
 
     // Home not supported by GameCube adapter.
-    outputs.home = inputs.home;
+    remap(InputBit::home, OutputBit::home),
 
     // L or Nunchuk Z = LT. Bind to "dodge" in-game.
-    if (inputs.nunchuk_connected) {
-        outputs.triggerLDigital = inputs.nunchuk_z;
-    } else {
-        outputs.triggerLDigital = inputs.l;
-    }
+    remap(InputBit::l, OutputBit::triggerLDigital, 0, NUNCHUK),
+    remap(InputBit::nunchuk_z, OutputBit::triggerLDigital, NUNCHUK),
 
     // R = RT. Can be bound to "pickup item" or left unbound.
-    outputs.triggerRDigital = inputs.r;
-
-    if (!inputs.mod_x) {
-        // Bind A to "attack" in-game.
-        outputs.a = inputs.a;
-
-        // Bind B to "special" in-game.
-        outputs.b = inputs.b;
-
-        // Z = RB. Bind to "dodge" in-game.
-        outputs.buttonR = inputs.z;
+    remap(InputBit::r, OutputBit::triggerRDigital),
 
-        // LS = LB. Not supported by GameCube adapter.
-        outputs.buttonL = inputs.lightshield;
-    }
+    // Bind A to "attack" in-game.
+    remap(InputBit::a, OutputBit::a, 0, MX),
+    // Bind B to "special" in-game.
+    remap(InputBit::b, OutputBit::b, 0, MX),
+    // Z = RB. Bind to "dodge" in-game.
+    remap(InputBit::z, OutputBit::buttonR, 0, MX),
+    // LS = LB. Not supported by GameCube adapter.
+    remap(InputBit::lightshield, OutputBit::buttonL, 0, MX),
 
     // MX activates a layer for "neutral" binds. Uses D-Pad buttons.
-    if (inputs.mod_x && !inputs.mod_y) {
-        // MX + A = D-Pad Left. Bind to "neutral attack" in-game.
-        outputs.dpadLeft = inputs.a;
-
-        // MX + B = D-Pad Right. Bind to "neutral special" in-game.
-        outputs.dpadRight = inputs.b;
-
-        // MX + Z = D-Pad Down. Bind to "neutral evade" in-game.
-        outputs.dpadDown = inputs.z;
-
-        // MX + LS = D-Pad Up. Bind to "taunt 1" in-game.
-        outputs.dpadUp = inputs.lightshield;
-    }
+    // MX + A = D-Pad Left. Bind to "neutral attack" in-game.
+    remap(InputBit::a, OutputBit::dpadLeft, MX, MY),
+    // MX + B = D-Pad Right. Bind to "neutral special" in-game.
+    remap(InputBit::b, OutputBit::dpadRight, MX, MY),
+    // MX + Z = D-Pad Down. Bind to "neutral evade" in-game.
+    remap(InputBit::z, OutputBit::dpadDown, MX, MY),
+    // MX + LS = D-Pad Up. Bind to "taunt 1" in-game.
+    remap(InputBit::lightshield, OutputBit::dpadUp, MX, MY),
 
     // MY activates C-Stick to D-Pad conversion.
-    if (inputs.mod_y && !inputs.mod_x) {
-        outputs.dpadLeft = inputs.c_left;
-        outputs.dpadRight = inputs.c_right;
-        outputs.dpadDown = inputs.c_down;
-        outputs.dpadUp = inputs.c_up;
-    }
-}
-
-void MultiVersus::UpdateAnalogOutputs(InputState &inputs, OutputState &outputs) {
-    // Coordinate calculations to make modifier handling simpler.
-    UpdateDirections(
-        inputs.left,
-        inputs.right,
-        inputs.down,
-        inputs.up,
-        inputs.c_left,
-        inputs.c_right,
-        inputs.c_down,
-        inputs.c_up,
-        ANALOG_STICK_MIN,
-        ANALOG_STICK_NEUTRAL,
-        ANALOG_STICK_MAX,
-        outputs
-    );
-
-    if (inputs.mod_y && !inputs.mod_x) {
-        // MY slows down the cursor for easier menu navigation.
-        // Menu cursor speed can also be turned down in-game under "Interface" settings.
-        // 128 ± 76 results in the slowest cursor that still actuates directional inputs in-game.
-        outputs.leftStickX = ANALOG_STICK_NEUTRAL + directions.x * 76;
-        outputs.leftStickY = ANALOG_STICK_NEUTRAL + directions.y * 76;
-
-        if (directions.diagonal) {
-            // Maintain a consistent cursor velocity when MY is held.
-            // ⌊76 × √2/2⌋ = 53
-            outputs.leftStickX = ANALOG_STICK_NEUTRAL + directions.x * 53;
-            outputs.leftStickY = ANALOG_STICK_NEUTRAL + directions.y * 53;
-        }
-
-        // Also shut off C-Stick for D-Pad conversion.
-        outputs.rightStickX = ANALOG_STICK_NEUTRAL;
-        outputs.rightStickY = ANALOG_STICK_NEUTRAL;
-    }
-
-    if (outputs.triggerLDigital) {
-        outputs.triggerLAnalog = 140;
-    }
-
-    if (outputs.triggerRDigital) {
-        outputs.triggerRAnalog = 140;
-    }
-
-    // Nunchuk overrides left stick.
-    if (inputs.nunchuk_connected) {
-        outputs.leftStickX = inputs.nunchuk_x;
-        outputs.leftStickY = inputs.nunchuk_y;
-    }
+    remap(InputBit::c_left, OutputBit::dpadLeft, MY, MX),
+    remap(InputBit::c_right, OutputBit::dpadRight, MY, MX),
+    remap(InputBit::c_down, OutputBit::dpadDown, MY, MX),
+    remap(InputBit::c_up, OutputBit::dpadUp, MY, MX),
+};
+
+constexpr CoordinateRow coordinate_rows[] MODE_TABLE = {
+    // MY slows down the cursor for easier menu navigation.
+    // Menu cursor speed can also be turned down in-game under "Interface" settings.
+    // 128 ± 76 results in the slowest cursor that still actuates directional inputs in-game.
+    coords(AXIS_LEFT_X | AXIS_LEFT_Y, 76, 76, MY, MX),
+    // Maintain a consistent cursor velocity when MY is held.
+    // ⌊76 × √2/2⌋ = 53
+    coords(AXIS_LEFT_X | AXIS_LEFT_Y, 53, 53, MY, MX, STICK_DIAGONAL),
+    // Also shut off C-Stick for D-Pad conversion.
+    coords(AXIS_RIGHT_X | AXIS_RIGHT_Y, 0, 0, MY, MX),
+};
+
+static const TableModeLayout layout = {
+    .left = input_mask(InputBit::left),
+    .right = input_mask(InputBit::right),
+    .down = input_mask(InputBit::down),
+    .up = input_mask(InputBit::up),
+    .c_left = input_mask(InputBit::c_left),
+    .c_right = input_mask(InputBit::c_right),
+    .c_down = input_mask(InputBit::c_down),
+    .c_up = input_mask(InputBit::c_up),
+    .analog_stick_min = ANALOG_STICK_MIN,
+    .analog_stick_neutral = ANALOG_STICK_NEUTRAL,
+    .analog_stick_max = ANALOG_STICK_MAX,
+    .output_mappings = output_mappings,
+    .output_mapping_count = sizeof(output_mappings) / sizeof(OutputMapping),
+    .coordinate_rows = coordinate_rows,
+    .coordinate_row_count = sizeof(coordinate_rows) / sizeof(CoordinateRow),
+    .trigger_analog = 140,
+    .nunchuk_left_stick = true,
+};
+
+MultiVersus::MultiVersus(socd::SocdType socd_type) : TableMode(layout) {
+    const socd::SocdPair socd_pairs[] = {
+        socd::SocdPair{InputBit::left,    InputBit::right,   socd_type},
+        socd::SocdPair{ InputBit::down,   InputBit::up,      socd_type},
+        socd::SocdPair{ InputBit::c_left, InputBit::c_right, socd_type},
+        socd::SocdPair{ InputBit::c_down, InputBit::c_up,    socd_type},
+    };
+    SetSocdPairs(socd_pairs);
 }
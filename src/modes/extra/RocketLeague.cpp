@@ -4,90 +4,70 @@
 #define ANALOG_STICK_NEUTRAL 128
 #define ANALOG_STICK_MAX 255
 
-RocketLeague::RocketLeague(socd::SocdType socd_type) {
-    _socd_pair_count = 4;
-    _socd_pairs = new socd::SocdPair[_socd_pair_count]{
-        socd::SocdPair{&InputState::left,    &InputState::right,   socd_type               },
-        socd::SocdPair{ &InputState::down,   &InputState::mod_x,   socd::SOCD_DIR2_PRIORITY},
-        socd::SocdPair{ &InputState::c_left, &InputState::c_right, socd_type               },
-        socd::SocdPair{ &InputState::c_down, &InputState::c_up,    socd_type               },
-    };
-}
+#define MX input_mask(InputBit::mod_x)
+#define MY input_mask(InputBit::mod_y)
 
-void RocketLeague::UpdateDigitalOutputs(InputState &inputs, OutputState &outputs) {
-    outputs.a = inputs.a;
-    outputs.b = inputs.b;
-    outputs.x = inputs.midshield;
-    outputs.y = inputs.up;
-    outputs.buttonL = inputs.l;
-    outputs.buttonR = inputs.lightshield;
-    outputs.triggerLDigital = inputs.z;
-    outputs.triggerRDigital = inputs.x;
-    outputs.leftStickClick = inputs.r;
+constexpr OutputMapping output_mappings[] MODE_TABLE = {
+    remap(InputBit::a, OutputBit::a),
+    remap(InputBit::b, OutputBit::b),
+    remap(InputBit::midshield, OutputBit::x),
+    remap(InputBit::up, OutputBit::y),
+    remap(InputBit::l, OutputBit::buttonL),
+    remap(InputBit::lightshield, OutputBit::buttonR),
+    remap(InputBit::z, OutputBit::triggerLDigital),
+    remap(InputBit::r, OutputBit::leftStickClick),
 
-    // Hold accelerate and reverse simultaneously for rear view.
-    if (inputs.z && inputs.x) {
-        outputs.rightStickClick = true;
-        // Override (deactivate) accelerator.
-        outputs.triggerRDigital = false;
-    }
+    // Hold accelerate and reverse simultaneously for rear view. This deactivates the accelerator.
+    remap(InputBit::x, OutputBit::triggerRDigital, 0, input_mask(InputBit::z)),
+    remap(InputBit::x, OutputBit::rightStickClick, input_mask(InputBit::z)),
 
     // MX + Start = Select
-    if (inputs.mod_x)
-        outputs.select = inputs.start;
-    else
-        outputs.start = inputs.start;
+    remap(InputBit::start, OutputBit::select, MX),
+    remap(InputBit::start, OutputBit::start, 0, MX),
 
     // D-Pad
-    if (inputs.mod_x && inputs.mod_y) {
-        outputs.dpadUp = inputs.c_up;
-        outputs.dpadDown = inputs.c_down;
-        outputs.dpadLeft = inputs.c_left;
-        outputs.dpadRight = inputs.c_right;
-    }
-}
-
-void RocketLeague::UpdateAnalogOutputs(InputState &inputs, OutputState &outputs) {
-    // Coordinate calculations to make modifier handling simpler.
-    UpdateDirections(
-        inputs.left,
-        inputs.right,
-        inputs.down,
-        inputs.mod_x,
-        inputs.c_left,
-        inputs.c_right,
-        inputs.c_down,
-        inputs.c_up,
-        ANALOG_STICK_MIN,
-        ANALOG_STICK_NEUTRAL,
-        ANALOG_STICK_MAX,
-        outputs
-    );
-
-    if (inputs.mod_y) {
-        if (directions.diagonal) {
-            outputs.leftStickX = ANALOG_STICK_NEUTRAL + (directions.x * 70);
-            // outputs.leftStickY =
-            // ANALOG_STICK_NEUTRAL + (directions.y * 76);
-        } else if (directions.horizontal) {
-            outputs.leftStickX = ANALOG_STICK_NEUTRAL + (directions.x * 35);
-        } else if (directions.vertical) {
-            outputs.leftStickY = ANALOG_STICK_NEUTRAL + (directions.y * 76);
-        }
-    } else if (directions.diagonal) {
-        // Good speed flip angle with no mods.
-        outputs.leftStickX = ANALOG_STICK_NEUTRAL + (directions.x * 70);
-    }
+    remap(InputBit::c_up, OutputBit::dpadUp, MX | MY),
+    remap(InputBit::c_down, OutputBit::dpadDown, MX | MY),
+    remap(InputBit::c_left, OutputBit::dpadLeft, MX | MY),
+    remap(InputBit::c_right, OutputBit::dpadRight, MX | MY),
+};
 
+constexpr CoordinateRow coordinate_rows[] MODE_TABLE = {
+    coords(AXIS_LEFT_X, 70, 0, MY, 0, STICK_DIAGONAL),
+    coords(AXIS_LEFT_X, 35, 0, MY, 0, STICK_HORIZONTAL, STICK_VERTICAL),
+    coords(AXIS_LEFT_Y, 0, 76, MY, 0, STICK_VERTICAL, STICK_HORIZONTAL),
+    // Good speed flip angle with no mods.
+    coords(AXIS_LEFT_X, 70, 0, 0, MY, STICK_DIAGONAL),
     // Shut off right stick when using dpad layer.
-    if (inputs.mod_x && inputs.mod_y) {
-        outputs.rightStickX = ANALOG_STICK_NEUTRAL;
-        outputs.rightStickY = ANALOG_STICK_NEUTRAL;
-    }
+    coords(AXIS_RIGHT_X | AXIS_RIGHT_Y, 0, 0, MX | MY),
+};
+
+static const TableModeLayout layout = {
+    .left = input_mask(InputBit::left),
+    .right = input_mask(InputBit::right),
+    .down = input_mask(InputBit::down),
+    .up = input_mask(InputBit::mod_x),
+    .c_left = input_mask(InputBit::c_left),
+    .c_right = input_mask(InputBit::c_right),
+    .c_down = input_mask(InputBit::c_down),
+    .c_up = input_mask(InputBit::c_up),
+    .analog_stick_min = ANALOG_STICK_MIN,
+    .analog_stick_neutral = ANALOG_STICK_NEUTRAL,
+    .analog_stick_max = ANALOG_STICK_MAX,
+    .output_mappings = output_mappings,
+    .output_mapping_count = sizeof(output_mappings) / sizeof(OutputMapping),
+    .coordinate_rows = coordinate_rows,
+    .coordinate_row_count = sizeof(coordinate_rows) / sizeof(CoordinateRow),
+    .trigger_analog = 0,
+    .nunchuk_left_stick = true,
+};
 
-    // Nunchuk overrides left stick.
-    if (inputs.nunchuk_connected) {
-        outputs.leftStickX = inputs.nunchuk_x;
-        outputs.leftStickY = inputs.nunchuk_y;
-    }
+RocketLeague::RocketLeague(socd::SocdType socd_type) : TableMode(layout) {
+    const socd::SocdPair socd_pairs[] = {
+        socd::SocdPair{InputBit::left,    InputBit::right,   socd_type               },
+        socd::SocdPair{ InputBit::down,   InputBit::mod_x,   socd::SOCD_DIR2_PRIORITY},
+        socd::SocdPair{ InputBit::c_left, InputBit::c_right, socd_type               },
+        socd::SocdPair{ InputBit::c_down, InputBit::c_up,    socd_type               },
+    };
+    SetSocdPairs(socd_pairs);
 }
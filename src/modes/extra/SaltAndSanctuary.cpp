@@ -4,49 +4,51 @@
 #define ANALOG_STICK_NEUTRAL 128
 #define ANALOG_STICK_MAX 255
 
-SaltAndSanctuary::SaltAndSanctuary(socd::SocdType socd_type) {
-    _socd_pair_count = 4;
-    _socd_pairs = new socd::SocdPair[_socd_pair_count]{
-        socd::SocdPair{&InputState::left,    &InputState::right,   socd_type},
-        socd::SocdPair{ &InputState::down,   &InputState::mod_x,   socd_type},
-        socd::SocdPair{ &InputState::c_left, &InputState::c_right, socd_type},
-        socd::SocdPair{ &InputState::c_down, &InputState::c_up,    socd_type},
+constexpr OutputMapping output_mappings[] MODE_TABLE = {
+    remap(InputBit::l, OutputBit::dpadRight), // Block
+    remap(InputBit::b, OutputBit::b), // Roll
+    remap(InputBit::a, OutputBit::a), // Attack
+    remap(InputBit::z, OutputBit::y), // Strong
+    remap(InputBit::mod_y, OutputBit::dpadDown), // Use
+    remap(InputBit::x, OutputBit::x), // Jump
+
+    remap(InputBit::r, OutputBit::buttonL), // Previous item
+    remap(InputBit::y, OutputBit::buttonR), // Next item
+    remap(InputBit::lightshield, OutputBit::triggerLDigital), // Use item
+
+    remap(InputBit::midshield, OutputBit::triggerRDigital), // Use torch
+
+    remap(InputBit::up, OutputBit::dpadLeft), // Switch loadout
+
+    remap(InputBit::start, OutputBit::start), // Inventory
+};
+
+static const TableModeLayout layout = {
+    .left = input_mask(InputBit::left),
+    .right = input_mask(InputBit::right),
+    .down = input_mask(InputBit::down),
+    .up = input_mask(InputBit::mod_x),
+    .c_left = input_mask(InputBit::c_left),
+    .c_right = input_mask(InputBit::c_right),
+    .c_down = input_mask(InputBit::c_down),
+    .c_up = input_mask(InputBit::c_up),
+    .analog_stick_min = ANALOG_STICK_MIN,
+    .analog_stick_neutral = ANALOG_STICK_NEUTRAL,
+    .analog_stick_max = ANALOG_STICK_MAX,
+    .output_mappings = output_mappings,
+    .output_mapping_count = sizeof(output_mappings) / sizeof(OutputMapping),
+    .coordinate_rows = nullptr,
+    .coordinate_row_count = 0,
+    .trigger_analog = 0,
+    .nunchuk_left_stick = false,
+};
+
+SaltAndSanctuary::SaltAndSanctuary(socd::SocdType socd_type) : TableMode(layout) {
+    const socd::SocdPair socd_pairs[] = {
+        socd::SocdPair{InputBit::left,    InputBit::right,   socd_type},
+        socd::SocdPair{ InputBit::down,   InputBit::mod_x,   socd_type},
+        socd::SocdPair{ InputBit::c_left, InputBit::c_right, socd_type},
+        socd::SocdPair{ InputBit::c_down, InputBit::c_up,    socd_type},
     };
-}
-
-void SaltAndSanctuary::UpdateDigitalOutputs(InputState &inputs, OutputState &outputs) {
-    outputs.dpadRight = inputs.l; // Block
-    outputs.b = inputs.b; // Roll
-    outputs.a = inputs.a; // Attack
-    outputs.y = inputs.z; // Strong
-    outputs.dpadDown = inputs.mod_y; // Use
-    outputs.x = inputs.x; // Jump
-
-    outputs.buttonL = inputs.r; // Previous item
-    outputs.buttonR = inputs.y; // Next item
-    outputs.triggerLDigital = inputs.lightshield; // Use item
-
-    outputs.triggerRDigital = inputs.midshield; // Use torch
-
-    outputs.dpadLeft = inputs.up; // Switch loadout
-
-    outputs.start = inputs.start; // Inventory
-}
-
-void SaltAndSanctuary::UpdateAnalogOutputs(InputState &inputs, OutputState &outputs) {
-    // Coordinate calculations to make modifier handling simpler.
-    UpdateDirections(
-        inputs.left,
-        inputs.right,
-        inputs.down,
-        inputs.mod_x,
-        inputs.c_left,
-        inputs.c_right,
-        inputs.c_down,
-        inputs.c_up,
-        ANALOG_STICK_MIN,
-        ANALOG_STICK_NEUTRAL,
-        ANALOG_STICK_MAX,
-        outputs
-    );
+    SetSocdPairs(socd_pairs);
 }
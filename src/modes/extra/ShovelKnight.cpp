@@ -4,46 +4,49 @@
 #define ANALOG_STICK_NEUTRAL 128
 #define ANALOG_STICK_MAX 255
 
-ShovelKnight::ShovelKnight(socd::SocdType socd_type) {
-    _socd_pair_count = 4;
-    _socd_pairs = new socd::SocdPair[_socd_pair_count]{
-        socd::SocdPair{&InputState::left,    &InputState::right,   socd_type},
-        socd::SocdPair{ &InputState::down,   &InputState::mod_x,   socd_type},
-        socd::SocdPair{ &InputState::c_left, &InputState::c_right, socd_type},
-        socd::SocdPair{ &InputState::c_down, &InputState::c_up,    socd_type},
-    };
-}
+constexpr OutputMapping output_mappings[] MODE_TABLE = {
+    remap(InputBit::left, OutputBit::dpadLeft),
+    remap(InputBit::right, OutputBit::dpadRight),
+    remap(InputBit::down, OutputBit::dpadDown),
+    remap(InputBit::mod_x, OutputBit::dpadUp),
 
-void ShovelKnight::UpdateDigitalOutputs(InputState &inputs, OutputState &outputs) {
-    outputs.dpadLeft = inputs.left;
-    outputs.dpadRight = inputs.right;
-    outputs.dpadDown = inputs.down;
-    outputs.dpadUp = inputs.mod_x;
+    remap(InputBit::x, OutputBit::b), // Jump
+    remap(InputBit::a, OutputBit::a), // Attack
+    remap(InputBit::b, OutputBit::y), // Attack
+    remap(InputBit::z, OutputBit::x), // Subweapon
+    remap(InputBit::r, OutputBit::buttonL), // Subweapon prev
+    remap(InputBit::y, OutputBit::buttonR), // Subweapon next
 
-    outputs.b = inputs.x; // Jump
-    outputs.a = inputs.a; // Attack
-    outputs.y = inputs.b; // Attack
-    outputs.x = inputs.z; // Subweapon
-    outputs.buttonL = inputs.r; // Subweapon prev
-    outputs.buttonR = inputs.y; // Subweapon next
+    remap(InputBit::lightshield, OutputBit::select), // Inventory
+    remap(InputBit::start, OutputBit::start), // Pause
+};
 
-    outputs.select = inputs.lightshield; // Inventory
-    outputs.start = inputs.start; // Pause
-}
+static const TableModeLayout layout = {
+    .left = input_mask(InputBit::left),
+    .right = input_mask(InputBit::right),
+    .down = input_mask(InputBit::down),
+    .up = input_mask(InputBit::mod_x),
+    .c_left = input_mask(InputBit::c_left),
+    .c_right = input_mask(InputBit::c_right),
+    .c_down = input_mask(InputBit::c_down),
+    .c_up = input_mask(InputBit::c_up),
+    .analog_stick_min = ANALOG_STICK_MIN,
+    .analog_stick_neutral = ANALOG_STICK_NEUTRAL,
+    .analog_stick_max = ANALOG_STICK_MAX,
+    .output_mappings = output_mappings,
+    .output_mapping_count = sizeof(output_mappings) / sizeof(OutputMapping),
+    .coordinate_rows = nullptr,
+    .coordinate_row_count = 0,
+    .trigger_analog = 0,
+    .nunchuk_left_stick = false,
+};
 
-void ShovelKnight::UpdateAnalogOutputs(InputState &inputs, OutputState &outputs) {
-    UpdateDirections(
-        inputs.left,
-        inputs.right,
-        inputs.down,
-        inputs.mod_x,
-        inputs.c_left,
-        inputs.c_right,
-        inputs.c_down,
-        inputs.c_up,
-        ANALOG_STICK_MIN,
-        ANALOG_STICK_NEUTRAL,
-        ANALOG_STICK_MAX,
-        outputs
-    );
+ShovelKnight::ShovelKnight(socd::SocdType socd_type) : TableMode(layout) {
+    const socd::SocdPair socd_pairs[] = {
+        socd::SocdPair{InputBit::left,    InputBit::right,   socd_type},
+        socd::SocdPair{ InputBit::down,   InputBit::mod_x,   socd_type},
+        socd::SocdPair{ InputBit::c_left, InputBit::c_right, socd_type},
+        socd::SocdPair{ InputBit::c_down, InputBit::c_up,    socd_type},
+    };
+    SetSocdPairs(socd_pairs);
 }
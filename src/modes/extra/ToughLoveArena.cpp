@@ -1,10 +1,10 @@
 #include "modes/extra/ToughLoveArena.hpp"
 
 ToughLoveArena::ToughLoveArena(socd::SocdType socd_type) {
-    _socd_pair_count = 1;
-    _socd_pairs = new socd::SocdPair[_socd_pair_count]{
-        socd::SocdPair{&InputState::left, &InputState::right, socd_type},
+    const socd::SocdPair socd_pairs[] = {
+        socd::SocdPair{InputBit::left, InputBit::right, socd_type},
     };
+    SetSocdPairs(socd_pairs);
 }
 
 void ToughLoveArena::UpdateKeys(InputState &inputs) {
@@ -5,38 +5,63 @@
 #define ANALOG_STICK_NEUTRAL 128
 #define ANALOG_STICK_MAX 228
 
-Ultimate2::Ultimate2(socd::SocdType socd_type) {
-    _socd_pair_count = 4;
-    _socd_pairs = new socd::SocdPair[_socd_pair_count]{
-        socd::SocdPair{&InputState::left,    &InputState::right,   socd_type},
-        socd::SocdPair{ &InputState::down,   &InputState::up,      socd_type},
-        socd::SocdPair{ &InputState::c_left, &InputState::c_right, socd_type},
-        socd::SocdPair{ &InputState::c_down, &InputState::c_up,    socd_type},
-    };
-}
-
-void Ultimate2::UpdateDigitalOutputs(InputState &inputs, OutputState &outputs) {
-    outputs.a = inputs.a;
-    outputs.b = inputs.b;
-    outputs.x = inputs.x;
-    outputs.y = inputs.y;
-    outputs.buttonR = inputs.z;
-    outputs.triggerLDigital = inputs.l;
-    outputs.triggerRDigital = inputs.r;
-    outputs.start = inputs.start;
+#define DPAD_LAYER input_mask(InputBit::mod_x, InputBit::mod_y)
+#define NUNCHUK_C input_mask(InputBit::nunchuk_c)
+
+constexpr OutputMapping output_mappings[] MODE_TABLE = {
+    remap(InputBit::a, OutputBit::a),
+    remap(InputBit::b, OutputBit::b),
+    remap(InputBit::x, OutputBit::x),
+    remap(InputBit::y, OutputBit::y),
+    remap(InputBit::z, OutputBit::buttonR),
+    remap(InputBit::l, OutputBit::triggerLDigital),
+    remap(InputBit::r, OutputBit::triggerRDigital),
+    remap(InputBit::start, OutputBit::start),
 
     // Turn on D-Pad layer by holding Mod X + Mod Y, or Nunchuk C button.
-    if ((inputs.mod_x && inputs.mod_y) || inputs.nunchuk_c) {
-        outputs.dpadUp = inputs.c_up;
-        outputs.dpadDown = inputs.c_down;
-        outputs.dpadLeft = inputs.c_left;
-        outputs.dpadRight = inputs.c_right;
-    }
-
-    if (inputs.select)
-        outputs.dpadLeft = true;
-    if (inputs.home)
-        outputs.dpadRight = true;
+    remap(InputBit::c_up, OutputBit::dpadUp, DPAD_LAYER),
+    remap(InputBit::c_down, OutputBit::dpadDown, DPAD_LAYER),
+    remap(InputBit::c_left, OutputBit::dpadLeft, DPAD_LAYER),
+    remap(InputBit::c_right, OutputBit::dpadRight, DPAD_LAYER),
+    remap(InputBit::c_up, OutputBit::dpadUp, NUNCHUK_C),
+    remap(InputBit::c_down, OutputBit::dpadDown, NUNCHUK_C),
+    remap(InputBit::c_left, OutputBit::dpadLeft, NUNCHUK_C),
+    remap(InputBit::c_right, OutputBit::dpadRight, NUNCHUK_C),
+
+    remap(InputBit::select, OutputBit::dpadLeft),
+    remap(InputBit::home, OutputBit::dpadRight),
+};
+
+// The modifier coordinates are conditioned on more than the coordinate rows can express, so the
+// analog outputs are still computed by UpdateAnalogOutputs() below.
+static const TableModeLayout layout = {
+    .left = input_mask(InputBit::left),
+    .right = input_mask(InputBit::right),
+    .down = input_mask(InputBit::down),
+    .up = input_mask(InputBit::up),
+    .c_left = input_mask(InputBit::c_left),
+    .c_right = input_mask(InputBit::c_right),
+    .c_down = input_mask(InputBit::c_down),
+    .c_up = input_mask(InputBit::c_up),
+    .analog_stick_min = ANALOG_STICK_MIN,
+    .analog_stick_neutral = ANALOG_STICK_NEUTRAL,
+    .analog_stick_max = ANALOG_STICK_MAX,
+    .output_mappings = output_mappings,
+    .output_mapping_count = sizeof(output_mappings) / sizeof(OutputMapping),
+    .coordinate_rows = nullptr,
+    .coordinate_row_count = 0,
+    .trigger_analog = 140,
+    .nunchuk_left_stick = true,
+};
+
+Ultimate2::Ultimate2(socd::SocdType socd_type) : TableMode(layout) {
+    const socd::SocdPair socd_pairs[] = {
+        socd::SocdPair{InputBit::left,    InputBit::right,   socd_type},
+        socd::SocdPair{ InputBit::down,   InputBit::up,      socd_type},
+        socd::SocdPair{ InputBit::c_left, InputBit::c_right, socd_type},
+        socd::SocdPair{ InputBit::c_down, InputBit::c_up,    socd_type},
+    };
+    SetSocdPairs(socd_pairs);
 }
 
 void Ultimate2::UpdateAnalogOutputs(InputState &inputs, OutputState &outputs) {
@@ -184,4 +209,4 @@ void Ultimate2::UpdateAnalogOutputs(InputState &inputs, OutputState &outputs) {
         outputs.leftStickX = inputs.nunchuk_x;
         outputs.leftStickY = inputs.nunchuk_y;
     }
-}
\ No newline at end of file
+}
\ No newline at end of file